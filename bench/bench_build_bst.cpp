@@ -0,0 +1,372 @@
+// Tree construction and lookup benchmarks for build_bst.cpp.
+// dist: sorted = ascending pre-order (right chain), random = pre-order of a
+// random BST, degenerate = descending pre-order (left chain).
+#include "build_bst.cpp"
+#include "bench_common.hpp"
+
+#include <optional>
+#include <set>
+#include <system_error>
+
+namespace {
+
+using bench::Distribution;
+
+void BM_RecursiveBuild(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    if (dist != Distribution::random) {
+        // Recursion depth equals n for chains; this is what the iterative
+        // builder exists for
+        state.SkipWithError("recursive build overflows the stack on chains");
+        return;
+    }
+    const auto input = bench::preorder_keys(bench::size_arg(state), dist);
+    Solution<int> solution;
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        auto root = solution.sortedArrayToBST(input);
+        benchmark::DoNotOptimize(root.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+void BM_IterativeBuild(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto input = bench::preorder_keys(bench::size_arg(state), dist);
+    Solution<int> solution;
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        auto root = solution.sortedArrayToBSTIterative(input);
+        benchmark::DoNotOptimize(root.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+void BM_ArenaBuild(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto input = bench::preorder_keys(bench::size_arg(state), dist);
+    Solution<int> solution;
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        NodeArena<int> arena;
+        arena.reserve(input.size());
+        benchmark::DoNotOptimize(solution.sortedArrayToBSTIterative(input, arena));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+// Midpoint build of truly sorted keys, single-threaded (threads:1) or on
+// every core (threads:0 = hardware_concurrency). Arena nodes are 24 bytes,
+// so this one runs up to the array limit (10^8 by default)
+void BM_BalancedSortedBuild(benchmark::State& state) {
+    const auto keys = bench::even_keys(bench::size_arg(state));
+    const unsigned threads = state.range(1) ? static_cast<unsigned>(state.range(1)) : std::thread::hardware_concurrency();
+    Solution<int> solution;
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        NodeArena<int> arena;
+        benchmark::DoNotOptimize(solution.sortedArrayToBalancedBST(keys, arena, threads));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+void balanced_build_cases(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "threads"});
+    for (int64_t n = bench::kMinSize; n <= bench::kMaxSize; n *= 10) {
+        b->Args({n, 1});
+        b->Args({n, 0});
+    }
+}
+
+// Same input fed in 64 KiB chunks, as a reader thread would deliver it
+void BM_StreamingBuild(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto input = bench::preorder_keys(bench::size_arg(state), dist);
+    constexpr size_t kChunk = (64 << 10) / sizeof(int);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        StreamingBSTBuilder<int> builder;
+        for (size_t first = 0; first < input.size(); first += kChunk) {
+            builder.feed(std::span<const int>(input).subspan(first, std::min(kChunk, input.size() - first)));
+        }
+        auto root = builder.finish();
+        benchmark::DoNotOptimize(root.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+// Lookups over the same random BST: pointer chasing vs the frozen layout
+constexpr size_t kLookups = 1 << 14;
+
+const TreeNode<int>* pointer_find(const TreeNode<int>* node, int target) {
+    while (node && node->val != target) {
+        node = target < node->val ? node->left.get() : node->right.get();
+    }
+    return node;
+}
+
+void BM_PointerLookup(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    auto root = Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(n));
+    const auto probes = bench::random_probes(kLookups, n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int probe : probes) {
+            benchmark::DoNotOptimize(pointer_find(root.get(), probe));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+void BM_EytzingerLookup(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    EytzingerTree<int> tree(Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(n)));
+    const auto probes = bench::random_probes(kLookups, n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int probe : probes) {
+            benchmark::DoNotOptimize(tree.contains(probe));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+void BM_EytzingerBatchLookup(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    EytzingerTree<int> tree(Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(n)));
+    const auto probes = bench::random_probes(kLookups, n);
+    std::unique_ptr<bool[]> found(new bool[probes.size()]);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        tree.contains_many(probes, std::span<bool>(found.get(), probes.size()));
+        benchmark::DoNotOptimize(found.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+// Incremental inserts in key order: ascending, shuffled, descending
+std::vector<int> insert_order(int64_t n, Distribution dist) {
+    std::vector<int> keys = bench::even_keys(n);
+    if (dist == Distribution::random) std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+    if (dist == Distribution::degenerate) std::reverse(keys.begin(), keys.end());
+    return keys;
+}
+
+// Same lookups with the node arena / key array on 4K pages (std::allocator)
+// or on transparent 2M pages, first-touch or interleaved across NUMA nodes.
+// Arena nodes come from a single n-node block, so with huge pages the
+// whole tree is one aligned mapping.
+struct SmallPages {
+    template<typename T>
+    static std::allocator<T> make() { return {}; }
+};
+
+template<NumaPlacement Numa>
+struct TransparentHugePages {
+    template<typename T>
+    static HugePageAllocator<T> make() { return HugePageAllocator<T>({HugePages::transparent, Numa}); }
+};
+
+using HugePagesLocal = TransparentHugePages<NumaPlacement::first_touch>;
+using HugePagesInterleaved = TransparentHugePages<NumaPlacement::interleave>;
+
+// Building on huge pages throws std::system_error when the NUMA policy is
+// refused; skip the run then instead of timing memory placed some other way
+template<typename Build>
+bool build_or_skip(benchmark::State& state, Build build) {
+    try {
+        build();
+        return true;
+    } catch (const std::system_error& e) {
+        state.SkipWithError(e.what());
+        return false;
+    }
+}
+
+template<typename Pages>
+void BM_ArenaLookup(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    auto alloc = Pages::template make<ArenaTreeNode<int>>();
+    NodeArena<int, decltype(alloc)> arena(static_cast<size_t>(n), alloc);
+    const ArenaTreeNode<int>* root = nullptr;
+    if (!build_or_skip(state, [&] { root = Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(n), arena); })) {
+        return;
+    }
+    const auto probes = bench::random_probes(kLookups, n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int probe : probes) {
+            const ArenaTreeNode<int>* node = root;
+            while (node && node->val != probe) {
+                node = probe < node->val ? node->left : node->right;
+            }
+            benchmark::DoNotOptimize(node);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+template<typename Pages>
+void BM_PagedEytzingerLookup(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    std::optional<EytzingerTree<int, decltype(Pages::template make<int>())>> tree;
+    if (!build_or_skip(state, [&] {
+            tree.emplace(Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(n)), Pages::template make<int>());
+        })) {
+        return;
+    }
+    const auto probes = bench::random_probes(kLookups, n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int probe : probes) {
+            benchmark::DoNotOptimize(tree->contains(probe));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+void BM_BalancedInsert(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto keys = insert_order(bench::size_arg(state), dist);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        BalancedBST<int> tree;
+        for (int key : keys) tree.insert(key);
+        benchmark::DoNotOptimize(tree.root().get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+void BM_StdSetInsert(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto keys = insert_order(bench::size_arg(state), dist);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        std::set<int> tree;
+        for (int key : keys) tree.insert(key);
+        benchmark::DoNotOptimize(&*tree.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+void BM_BalancedFind(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    BalancedBST<int> tree;
+    for (int key : insert_order(n, Distribution::sorted)) tree.insert(key);
+    const auto probes = bench::random_probes(kLookups, n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int probe : probes) {
+            benchmark::DoNotOptimize(tree.contains(probe));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+// Snapshot lookups, with (rebuild:1) or without a writer republishing a
+// same-sized tree in the background
+void BM_ConcurrentLookup(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    const auto preorder = bench::random_preorder(n);
+    ConcurrentBST<int> tree(Solution<int>().sortedArrayToBSTIterative(preorder));
+    const auto probes = bench::random_probes(kLookups, n);
+
+    std::jthread writer;
+    if (state.range(1)) {
+        writer = std::jthread([&](std::stop_token stop) {
+            while (!stop.stop_requested()) tree.rebuild(preorder);
+        });
+    }
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        auto snapshot = tree.snapshot();
+        for (int probe : probes) {
+            benchmark::DoNotOptimize(snapshot.contains(probe));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(probes.size()));
+}
+
+// Full in-order walks of the same tree: callback, coroutine generator, and
+// a range query that covers a tenth of the keys via the generator
+void BM_InorderVisit(benchmark::State& state) {
+    auto root = Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(bench::size_arg(state)));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        inorderVisit(root.get(), [&sum](int val) { sum += val; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * bench::size_arg(state));
+}
+
+void BM_InorderGenerator(benchmark::State& state) {
+    auto root = Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(bench::size_arg(state)));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (int val : inorder(root.get())) {
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * bench::size_arg(state));
+}
+
+void BM_InorderRangeGenerator(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    auto root = Solution<int>().sortedArrayToBSTIterative(bench::random_preorder(n));
+    // Keys are the even numbers 0 .. 2n-2 (see random_preorder); the middle
+    // tenth of them lies in [n - n/10, n + n/10)
+    const int low = static_cast<int>(n - n / 10);
+    const int high = static_cast<int>(n + n / 10 - 1);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (int val : inorderRange(root.get(), low, high)) {
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (n / 10));
+}
+
+void concurrent_cases(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "rebuild"});
+    for (int64_t n = bench::kMinSize; n <= bench::kMaxTreeSize; n *= 10) {
+        b->Args({n, 0});
+        b->Args({n, 1});
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_RecursiveBuild)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IterativeBuild)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ArenaBuild)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BalancedSortedBuild)->Apply(balanced_build_cases)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_StreamingBuild)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PointerLookup)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EytzingerLookup)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EytzingerBatchLookup)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ArenaLookup, SmallPages)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ArenaLookup, HugePagesLocal)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ArenaLookup, HugePagesInterleaved)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PagedEytzingerLookup, SmallPages)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PagedEytzingerLookup, HugePagesLocal)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PagedEytzingerLookup, HugePagesInterleaved)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BalancedInsert)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdSetInsert)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BalancedFind)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InorderVisit)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InorderGenerator)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InorderRangeGenerator)->Apply(bench::tree_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConcurrentLookup)->Apply(concurrent_cases)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,154 @@
+// Shared input generators and argument sets for the benchmark suite.
+// Every benchmark takes (n, dist): n runs over powers of 10 from 10^3 to
+// the configured maximum, dist selects one of the input distributions below.
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifndef CODESTUDIO_BENCH_MAX_SIZE
+#define CODESTUDIO_BENCH_MAX_SIZE 100000000
+#endif
+#ifndef CODESTUDIO_BENCH_MAX_TREE_SIZE
+#define CODESTUDIO_BENCH_MAX_TREE_SIZE 10000000
+#endif
+
+namespace bench {
+
+inline constexpr int64_t kMinSize = 1000;
+inline constexpr int64_t kMaxSize = CODESTUDIO_BENCH_MAX_SIZE;
+inline constexpr int64_t kMaxTreeSize = CODESTUDIO_BENCH_MAX_TREE_SIZE;
+
+// What each distribution means is spelled out per benchmark file; broadly:
+// sorted = already ordered input, random = shuffled / typical input,
+// degenerate = the worst-case shape for the algorithm
+enum class Distribution : int64_t { sorted = 0, random = 1, degenerate = 2 };
+
+inline const char* name(Distribution d) {
+    switch (d) {
+        case Distribution::sorted: return "sorted";
+        case Distribution::random: return "random";
+        case Distribution::degenerate: return "degenerate";
+    }
+    return "?";
+}
+
+inline int64_t size_arg(const benchmark::State& state) { return state.range(0); }
+inline Distribution dist_arg(const benchmark::State& state) { return static_cast<Distribution>(state.range(1)); }
+
+inline void sizes_up_to(benchmark::internal::Benchmark* b, int64_t max, bool with_distributions) {
+    b->ArgNames(with_distributions ? std::vector<std::string>{"n", "dist"} : std::vector<std::string>{"n"});
+    for (int64_t n = kMinSize; n <= max; n *= 10) {
+        if (!with_distributions) {
+            b->Args({n});
+            continue;
+        }
+        for (int64_t d = 0; d < 3; ++d) {
+            b->Args({n, d});
+        }
+    }
+}
+
+// ->Apply(...) helpers
+inline void array_sizes(benchmark::internal::Benchmark* b) { sizes_up_to(b, kMaxSize, false); }
+inline void array_cases(benchmark::internal::Benchmark* b) { sizes_up_to(b, kMaxSize, true); }
+inline void tree_sizes(benchmark::internal::Benchmark* b) { sizes_up_to(b, kMaxTreeSize, false); }
+inline void tree_cases(benchmark::internal::Benchmark* b) { sizes_up_to(b, kMaxTreeSize, true); }
+
+// Even keys 0, 2, 4, ...: odd probes are guaranteed misses
+inline std::vector<int> even_keys(int64_t n) {
+    std::vector<int> keys(static_cast<size_t>(n));
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(2 * i);
+    }
+    return keys;
+}
+
+// Uniform probes over [0, 2n): about half hit an even key
+inline std::vector<int> random_probes(size_t count, int64_t n, uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(2 * n - 1));
+    std::vector<int> probes(count);
+    for (int& p : probes) p = pick(rng);
+    return probes;
+}
+
+// Pre-order of a random BST over the keys 2*[0, n): every subtree root is
+// a uniformly random key of its range (expected depth O(log n))
+inline std::vector<int> random_preorder(int64_t n, uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::vector<int> out;
+    out.reserve(static_cast<size_t>(n));
+    std::vector<std::pair<int64_t, int64_t>> ranges = {{0, n}};
+    while (!ranges.empty()) {
+        auto [lo, hi] = ranges.back();
+        ranges.pop_back();
+        if (lo >= hi) continue;
+        int64_t root = lo + static_cast<int64_t>(rng() % static_cast<uint64_t>(hi - lo));
+        out.push_back(static_cast<int>(2 * root));
+        ranges.push_back({root + 1, hi}); // right after left
+        ranges.push_back({lo, root});
+    }
+    return out;
+}
+
+// Pre-order keys shaped by distribution: ascending (right-leaning chain),
+// random BST, or descending (left-leaning chain)
+inline std::vector<int> preorder_keys(int64_t n, Distribution d) {
+    std::vector<int> keys = even_keys(n);
+    if (d == Distribution::random) return random_preorder(n);
+    if (d == Distribution::degenerate) std::reverse(keys.begin(), keys.end());
+    return keys;
+}
+
+// Build a unique_ptr tree from a valid pre-order sequence with a monotonic
+// stack (Node needs val/left/right); works for any TreeNode flavour
+template<typename Node, typename Key = int>
+std::unique_ptr<Node> tree_from_preorder(const std::vector<Key>& preorder) {
+    if (preorder.empty()) return nullptr;
+    auto root = std::make_unique<Node>(preorder[0]);
+    std::vector<Node*> stack = {root.get()};
+    for (size_t i = 1; i < preorder.size(); ++i) {
+        const Key& v = preorder[i];
+        Node* parent = nullptr;
+        while (!stack.empty() && stack.back()->val < v) {
+            parent = stack.back();
+            stack.pop_back();
+        }
+        if (parent) {
+            parent->right = std::make_unique<Node>(v);
+            stack.push_back(parent->right.get());
+        } else {
+            stack.back()->left = std::make_unique<Node>(v);
+            stack.push_back(stack.back()->left.get());
+        }
+    }
+    return root;
+}
+
+// Tear a tree down without recursion (rotate left children up, then drop
+// the root), for node types whose destructor recurses per level
+template<typename Node>
+void release_tree(std::unique_ptr<Node> node) {
+    while (node) {
+        if (node->left) {
+            auto child = std::move(node->left);
+            node->left = std::move(child->right);
+            child->right = std::move(node);
+            node = std::move(child);
+        } else {
+            auto next = std::move(node->right);
+            node = std::move(next);
+        }
+    }
+}
+
+} // namespace bench
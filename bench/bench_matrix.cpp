@@ -0,0 +1,92 @@
+// Matrix benchmarks for cpp23_features.cpp against a vector-of-vectors
+// baseline. n is the element count; the matrices are square with
+// side sqrt(n). Multiply is O(side^3), so it stops at 10^6 elements.
+#include "cpp23_features.cpp"
+#include "bench_common.hpp"
+
+#include <cmath>
+
+namespace {
+
+using Nested = std::vector<std::vector<int>>;
+
+size_t side(const benchmark::State& state) {
+    return static_cast<size_t>(std::sqrt(static_cast<double>(bench::size_arg(state))));
+}
+
+Matrix<int> filled_matrix(size_t n) {
+    Matrix<int> m(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) m[i, j] = static_cast<int>((i * 31 + j) % 17);
+    return m;
+}
+
+Nested filled_nested(size_t n) {
+    Nested m(n, std::vector<int>(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j) m[i][j] = static_cast<int>((i * 31 + j) % 17);
+    return m;
+}
+
+void BM_Transpose(benchmark::State& state) {
+    const auto m = filled_matrix(side(state));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        auto t = transpose(m);
+        benchmark::DoNotOptimize(&t[0, 0]);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(side(state) * side(state)));
+}
+
+void BM_NestedTranspose(benchmark::State& state) {
+    const size_t n = side(state);
+    const auto m = filled_nested(n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        Nested t(n, std::vector<int>(n));
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j) t[j][i] = m[i][j];
+        benchmark::DoNotOptimize(t.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n));
+}
+
+void BM_Multiply(benchmark::State& state) {
+    const auto a = filled_matrix(side(state));
+    const auto b = filled_matrix(side(state));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        auto c = multiply(a, b);
+        benchmark::DoNotOptimize(&c[0, 0]);
+    }
+}
+
+void BM_NestedMultiply(benchmark::State& state) {
+    const size_t n = side(state);
+    const auto a = filled_nested(n);
+    const auto b = filled_nested(n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        Nested c(n, std::vector<int>(n));
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j) {
+                int sum = 0;
+                for (size_t k = 0; k < n; ++k) sum += a[i][k] * b[k][j];
+                c[i][j] = sum;
+            }
+        benchmark::DoNotOptimize(c.data());
+    }
+}
+
+void multiply_sizes(benchmark::internal::Benchmark* b) {
+    bench::sizes_up_to(b, std::min<int64_t>(bench::kMaxSize, 1000000), false);
+}
+
+} // namespace
+
+BENCHMARK(BM_Transpose)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NestedTranspose)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Multiply)->Apply(multiply_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NestedMultiply)->Apply(multiply_sizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
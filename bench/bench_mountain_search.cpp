@@ -0,0 +1,116 @@
+// Search benchmarks for find_target_in_mountain_array.cpp.
+// dist places the peak: sorted = last element (ascending only), random = a
+// random index, degenerate = first element (descending only).
+#include "find_target_in_mountain_array.cpp"
+#include "bench_common.hpp"
+
+namespace {
+
+using bench::Distribution;
+
+constexpr size_t kQueries = 1 << 14;
+
+// Even values climb to the peak (2n), odd values descend from 2n - 1, so
+// every value in [0, 2n] appears at most once
+std::vector<int> mountain(int64_t n, Distribution dist) {
+    int64_t peak = 0;
+    if (dist == Distribution::sorted) peak = n - 1;
+    if (dist == Distribution::random) peak = static_cast<int64_t>(std::mt19937_64(7)() % static_cast<uint64_t>(n));
+    std::vector<int> arr(static_cast<size_t>(n));
+    for (int64_t i = 0; i < peak; ++i) arr[i] = static_cast<int>(2 * i);
+    arr[peak] = static_cast<int>(2 * n);
+    int next = static_cast<int>(2 * n) - 1;
+    for (int64_t i = peak + 1; i < n; ++i, next -= 2) arr[i] = next;
+    return arr;
+}
+
+void BM_FindTarget(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto arr = mountain(bench::size_arg(state), dist);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int target : queries) {
+            benchmark::DoNotOptimize(findTargetInMountainArray(arr, target));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+void BM_MountainIndex(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto arr = mountain(bench::size_arg(state), dist);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    const MountainIndex index(arr);
+    std::vector<int> results(queries.size());
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        index.find_many(queries, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+// Same queries one find() at a time: the baseline for find_many's
+// lock-step groups
+void BM_MountainIndexSingle(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto arr = mountain(bench::size_arg(state), dist);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    const MountainIndex index(arr);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int target : queries) {
+            benchmark::DoNotOptimize(index.find(target));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+// Crossover sweep for kLinearWindow: halving down to Window elements and
+// scanning the rest, against plain std::lower_bound on the same range.
+// Window = 1 is pure branchless halving.
+template<int Window>
+void BM_HybridWindow(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    const auto arr = bench::even_keys(n);
+    const auto queries = bench::random_probes(kQueries, n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int target : queries) {
+            benchmark::DoNotOptimize(hybridSearch<false, Window>(arr, target, 0, static_cast<int>(n - 1)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+void BM_StdLowerBound(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    const auto arr = bench::even_keys(n);
+    const auto queries = bench::random_probes(kQueries, n);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int target : queries) {
+            benchmark::DoNotOptimize(std::lower_bound(arr.begin(), arr.end(), target));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+} // namespace
+
+BENCHMARK(BM_FindTarget)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MountainIndex)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MountainIndexSingle)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HybridWindow, 1)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HybridWindow, 8)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HybridWindow, 16)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HybridWindow, 32)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HybridWindow, 64)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_HybridWindow, 128)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StdLowerBound)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,85 @@
+// Buffer reducer benchmarks for cpp17_features.cpp against std::accumulate.
+// all_positive exits early, so it also takes dist: sorted = all positive
+// (full scan), random = random signs (exits almost immediately),
+// degenerate = only the last element is negative (full scan, then fail).
+#include "cpp17_features.cpp"
+#include "bench_common.hpp"
+
+namespace {
+
+using bench::Distribution;
+
+std::vector<float> float_values(int64_t n) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<float> pick(0.5f, 1.5f);
+    std::vector<float> values(static_cast<size_t>(n));
+    for (float& v : values) v = pick(rng);
+    return values;
+}
+
+void BM_Accumulate(benchmark::State& state) {
+    const auto values = float_values(bench::size_arg(state));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(values.begin(), values.end(), 0.0f));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::size_arg(state) * static_cast<int64_t>(sizeof(float)));
+}
+
+void BM_SumAll(benchmark::State& state) {
+    const auto values = float_values(bench::size_arg(state));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_all(ArrayView(values)));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::size_arg(state) * static_cast<int64_t>(sizeof(float)));
+}
+
+void BM_SumAllParallel(benchmark::State& state) {
+    const auto values = float_values(bench::size_arg(state));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_all(std::execution::par, ArrayView(values)));
+    }
+    state.SetBytesProcessed(state.iterations() * bench::size_arg(state) * static_cast<int64_t>(sizeof(float)));
+}
+
+std::vector<int> signed_values(int64_t n, Distribution dist) {
+    std::vector<int> values(static_cast<size_t>(n), 1);
+    if (dist == Distribution::random) {
+        std::mt19937_64 rng(42);
+        for (int& v : values) v = (rng() & 1) ? 1 : -1;
+    }
+    if (dist == Distribution::degenerate) values.back() = -1;
+    return values;
+}
+
+void BM_AllOf(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto values = signed_values(bench::size_arg(state), dist);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::all_of(values.begin(), values.end(), [](int v) { return v > 0; }));
+    }
+}
+
+void BM_AllPositive(benchmark::State& state) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto values = signed_values(bench::size_arg(state), dist);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(all_positive(ArrayView(values)));
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_Accumulate)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SumAll)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SumAllParallel)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_AllOf)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AllPositive)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
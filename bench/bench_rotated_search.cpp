@@ -0,0 +1,103 @@
+// Search benchmarks for find_target_in_rotated_sorted_array.cpp.
+// dist picks the rotation offset: sorted = 0 (no rotation), random = a
+// random offset, degenerate = n - 1 (a single element before the pivot).
+#include "find_target_in_rotated_sorted_array.cpp"
+#include "bench_common.hpp"
+
+namespace {
+
+using bench::Distribution;
+
+constexpr size_t kQueries = 1 << 14;
+
+std::vector<int> rotated_keys(benchmark::State& state) {
+    const int64_t n = bench::size_arg(state);
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    std::vector<int> keys = bench::even_keys(n);
+    int64_t offset = 0;
+    if (dist == Distribution::random) offset = static_cast<int64_t>(std::mt19937_64(7)() % static_cast<uint64_t>(n));
+    if (dist == Distribution::degenerate) offset = n - 1;
+    std::rotate(keys.begin(), keys.begin() + offset, keys.end());
+    return keys;
+}
+
+void BM_Search(benchmark::State& state) {
+    const auto keys = rotated_keys(state);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int target : queries) {
+            benchmark::DoNotOptimize(search(keys, target));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+void BM_SearchMany(benchmark::State& state) {
+    const auto keys = rotated_keys(state);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    std::vector<int> results(queries.size());
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        searchMany(keys, queries, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+// Pivot found once, then a plain lower_bound per query
+void BM_RotatedViewFind(benchmark::State& state) {
+    const auto keys = rotated_keys(state);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    const RotatedView view(keys);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int target : queries) {
+            benchmark::DoNotOptimize(view.find(target));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+// Keys in [q, q + 1000]: two binary searches against a linear count
+void BM_RotatedViewCount(benchmark::State& state) {
+    const auto keys = rotated_keys(state);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    const RotatedView view(keys);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        for (int low : queries) {
+            benchmark::DoNotOptimize(view.count(low, low + 1000));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+// One query per iteration (a full scan each), cycling through the same
+// probes; items are queries as above, "elements" is the scan rate
+void BM_ScanCount(benchmark::State& state) {
+    const auto keys = rotated_keys(state);
+    const auto queries = bench::random_probes(kQueries, bench::size_arg(state));
+    size_t next = 0;
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        const int low = queries[next++ % queries.size()];
+        benchmark::DoNotOptimize(std::count_if(keys.begin(), keys.end(),
+                                               [&](int k) { return k >= low && k <= low + 1000; }));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["elements"] = benchmark::Counter(static_cast<double>(keys.size()),
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+}
+
+} // namespace
+
+BENCHMARK(BM_Search)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SearchMany)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_RotatedViewFind)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RotatedViewCount)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ScanCount)->Apply(bench::array_cases)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
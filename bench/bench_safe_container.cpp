@@ -0,0 +1,48 @@
+// SafeContainer benchmarks for cpp26_features.cpp: the cost of each bounds
+// check policy on per-element access, and with one check per range.
+#include "cpp26_features.cpp"
+#include "bench_common.hpp"
+
+namespace {
+
+template<typename Policy>
+SafeContainer<Policy> make_container(const benchmark::State& state) {
+    std::vector<int> values(static_cast<size_t>(bench::size_arg(state)));
+    std::iota(values.begin(), values.end(), 0);
+    return SafeContainer<Policy>(std::move(values));
+}
+
+template<typename Policy>
+void BM_PerElement(benchmark::State& state) {
+    const auto container = make_container<Policy>(state);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (size_t i = 0; i < container.size(); ++i) sum += container.safe_get(i);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * bench::size_arg(state));
+}
+
+template<typename Policy>
+void BM_SafeRange(benchmark::State& state) {
+    const auto container = make_container<Policy>(state);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int v : container.safe_range(0, container.size())) sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * bench::size_arg(state));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_PerElement, CheckedAccess)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PerElement, DebugAssertAccess)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PerElement, UncheckedAccess)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PerElement, HardenedTrapAccess)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SafeRange, CheckedAccess)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SafeRange, UncheckedAccess)->Apply(bench::array_sizes)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+// Validation benchmarks for validate_bst.cpp, one per traversal strategy.
+// dist: sorted = ascending pre-order (right chain), random = random BST,
+// degenerate = descending pre-order (left chain).
+#include "validate_bst.cpp"
+#include "bench_common.hpp"
+
+#include <string>
+
+namespace {
+
+// validate_bst's TreeNode destroys recursively, so the fixture owns the
+// tree and tears it down iteratively
+struct TreeFixture {
+    std::unique_ptr<TreeNode<int>> root;
+
+    explicit TreeFixture(benchmark::State& state) {
+        const auto dist = bench::dist_arg(state);
+        state.SetLabel(bench::name(dist));
+        root = bench::tree_from_preorder<TreeNode<int>>(bench::preorder_keys(bench::size_arg(state), dist));
+    }
+    ~TreeFixture() { bench::release_tree(std::move(root)); }
+};
+
+template<typename Validate>
+void run(benchmark::State& state, Validate validate) {
+    TreeFixture fixture(state);
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validate(fixture.root));
+    }
+    state.SetItemsProcessed(state.iterations() * bench::size_arg(state));
+}
+
+void BM_HeapStack(benchmark::State& state) {
+    Solution<int> solution;
+    run(state, [&](const auto& root) { return solution.isValidBST(root); });
+}
+
+void BM_InlineStack64(benchmark::State& state) {
+    Solution<int> solution;
+    run(state, [&](const auto& root) { return solution.template isValidBST<InlineStackTraversal<64>>(root); });
+}
+
+void BM_Morris(benchmark::State& state) {
+    Solution<int> solution;
+    run(state, [&](const auto& root) { return solution.template isValidBST<MorrisTraversal>(root); });
+}
+
+void BM_Parallel(benchmark::State& state) {
+    Solution<int> solution;
+    run(state, [&](const auto& root) { return solution.isValidBSTParallel(root).valid; });
+}
+
+// String keys: the same tree shapes over random lowercase words of 6-24
+// letters, as std::string (heap buffer past 15 chars) and as StringKey
+std::vector<std::string> sorted_words(int64_t n) {
+    std::mt19937_64 rng(42);
+    std::vector<std::string> words(static_cast<size_t>(n));
+    for (auto& word : words) {
+        word.resize(6 + rng() % 19);
+        for (char& c : word) c = static_cast<char>('a' + rng() % 26);
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+// Pre-order of string keys in the shape preorder_keys gives for ints
+template<typename Key, typename MakeKey>
+std::vector<Key> string_preorder(benchmark::State& state, MakeKey make_key) {
+    const auto dist = bench::dist_arg(state);
+    state.SetLabel(bench::name(dist));
+    const auto words = sorted_words(bench::size_arg(state));
+    std::vector<Key> keys;
+    keys.reserve(words.size());
+    for (int index : bench::preorder_keys(static_cast<int64_t>(words.size()), dist)) {
+        keys.push_back(make_key(words[static_cast<size_t>(index / 2)]));
+    }
+    return keys;
+}
+
+void BM_StdStringKeys(benchmark::State& state) {
+    auto root = bench::tree_from_preorder<TreeNode<std::string>>(
+        string_preorder<std::string>(state, [](const std::string& w) { return w; }));
+    Solution<std::string> solution;
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution.isValidBST(root));
+    }
+    state.SetItemsProcessed(state.iterations() * bench::size_arg(state));
+    bench::release_tree(std::move(root));
+}
+
+void BM_PrefixStringKeys(benchmark::State& state) {
+    StringArena arena;
+    auto root = bench::tree_from_preorder<TreeNode<StringKey>>(
+        string_preorder<StringKey>(state, [&](const std::string& w) { return StringKey(w, arena); }));
+    Solution<StringKey> solution;
+    bench::CounterScope counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution.isValidBST(root));
+    }
+    state.SetItemsProcessed(state.iterations() * bench::size_arg(state));
+    bench::release_tree(std::move(root));
+}
+
+} // namespace
+
+BENCHMARK(BM_HeapStack)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InlineStack64)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Morris)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Parallel)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_StdStringKeys)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PrefixStringKeys)->Apply(bench::tree_cases)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
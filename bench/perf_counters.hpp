@@ -0,0 +1,181 @@
+// Hardware performance counters for the benchmark suite, read through
+// perf_event_open(2). Put a CounterScope right before a benchmark's timing
+// loop and the events below are reported as per-iteration user counters
+// next to the wall-clock time, in the console table and in
+// --benchmark_format=json / --benchmark_out output alike.
+//
+// Counting is user-space only (exclude_kernel), which is what the default
+// kernel.perf_event_paranoid=2 allows. Events the machine cannot count
+// (no PMU in a VM, paranoid=3, hybrid cores missing an event, ...) are
+// left out rather than reported as zero; the list of live events is
+// recorded once in the "perf_counters" context field.
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#ifndef CODESTUDIO_BENCH_PERF_COUNTERS
+#define CODESTUDIO_BENCH_PERF_COUNTERS 1
+#endif
+
+#if CODESTUDIO_BENCH_PERF_COUNTERS && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CODESTUDIO_HAVE_PERF_EVENTS 1
+#else
+#define CODESTUDIO_HAVE_PERF_EVENTS 0
+#endif
+
+namespace bench {
+
+#if CODESTUDIO_HAVE_PERF_EVENTS
+
+struct PerfEvent {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cache_miss(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+inline constexpr std::array<PerfEvent, 7> kPerfEvents = {{
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"l1d_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+    {"llc_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"dtlb_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB)},
+    {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+}};
+
+// One file descriptor per event, opened once for the process. Events are
+// not grouped: a group is all-or-nothing, and one unsupported cache event
+// should not hide the cycle count. inherit=1 folds in threads the
+// benchmark spawns (parallel builders and validators) once they exit.
+class PerfCounters {
+public:
+    using Values = std::array<double, kPerfEvents.size()>;
+
+    static PerfCounters& instance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    bool available(size_t i) const { return fds_[i] >= 0; }
+
+    void start() {
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    // Stop counting and return each event's count, scaled up when the
+    // kernel had to multiplex more events than the PMU has counters
+    Values stop() {
+        for (int fd : fds_) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        Values values{};
+        for (size_t i = 0; i < fds_.size(); ++i) {
+            struct { uint64_t value, enabled, running; } sample{};
+            if (fds_[i] < 0 || read(fds_[i], &sample, sizeof(sample)) != sizeof(sample)) {
+                continue;
+            }
+            values[i] = sample.running == 0 ? 0.0
+                : static_cast<double>(sample.value) * static_cast<double>(sample.enabled) /
+                  static_cast<double>(sample.running);
+        }
+        return values;
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+private:
+    PerfCounters() {
+        std::string live;
+        for (size_t i = 0; i < kPerfEvents.size(); ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = kPerfEvents[i].type;
+            attr.config = kPerfEvents[i].config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds_[i] >= 0) {
+                live += live.empty() ? "" : ",";
+                live += kPerfEvents[i].name;
+            }
+        }
+        benchmark::AddCustomContext("perf_counters", live.empty() ? "unavailable" : live);
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds_) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    std::array<int, kPerfEvents.size()> fds_;
+};
+
+// Open the counters during static initialization so the context field is
+// set before RunSpecifiedBenchmarks prints the run context
+inline const bool kPerfCountersOpened = (PerfCounters::instance(), true);
+
+// Counts everything from construction to destruction (the whole timing
+// loop, including any PauseTiming sections) and divides by the number of
+// iterations. Adds an "ipc" counter when cycles and instructions are both
+// live.
+class CounterScope {
+public:
+    explicit CounterScope(benchmark::State& state) : state_(state) {
+        PerfCounters::instance().start();
+    }
+
+    ~CounterScope() {
+        auto& counters = PerfCounters::instance();
+        const auto values = counters.stop();
+        if (state_.error_occurred() || state_.iterations() == 0) {
+            return;
+        }
+        for (size_t i = 0; i < kPerfEvents.size(); ++i) {
+            if (counters.available(i)) {
+                state_.counters[kPerfEvents[i].name] =
+                    benchmark::Counter(values[i], benchmark::Counter::kAvgIterations);
+            }
+        }
+        if (counters.available(0) && counters.available(1) && values[0] > 0) {
+            state_.counters["ipc"] = values[1] / values[0];
+        }
+    }
+
+    CounterScope(const CounterScope&) = delete;
+    CounterScope& operator=(const CounterScope&) = delete;
+
+private:
+    benchmark::State& state_;
+};
+
+#else
+
+class CounterScope {
+public:
+    explicit CounterScope(benchmark::State&) {}
+};
+
+#endif // CODESTUDIO_HAVE_PERF_EVENTS
+
+} // namespace bench
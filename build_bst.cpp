@@ -1,8 +1,42 @@
 #include <iostream>
 #include <memory>
 #include <vector>
+#include <algorithm>
 #include <concepts>
 #include <limits>
+#include <utility>
+#include <type_traits>
+#include <span>
+#include <bit>
+#include <cstdint>
+#include <array>
+#include <string_view>
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <coroutine>
+#include <exception>
+#include <ranges>
+#include <iterator>
+#include <new>
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 // C++20 Concept to ensure value type is ordered and supports comparison
 template<typename T>
@@ -15,12 +49,523 @@ concept Ordered = requires(T a, T b) {
 template<typename T>
 struct TreeNode {
     T val;
+    // Subtree height, maintained by BalancedBST only; kept next to val so it
+    // sits in padding instead of growing every node
+    uint8_t height = 1;
     // Using std::unique_ptr for automatic memory management (RAII)
     // No manual delete needed. Prevents memory leaks.
     std::unique_ptr<TreeNode<T>> left;
     std::unique_ptr<TreeNode<T>> right;
 
     TreeNode(const T& x) : val(x), left(nullptr), right(nullptr) {}
+
+    // Tear subtrees down iteratively: the default destructor recurses once per
+    // level, which overflows the stack on degenerate (list-shaped) trees
+    ~TreeNode() {
+        release(std::move(left));
+        release(std::move(right));
+    }
+
+private:
+    static void release(std::unique_ptr<TreeNode<T>> node) {
+        while (node) {
+            if (node->left) {
+                // Rotate right so the left child becomes the new top
+                auto child = std::move(node->left);
+                node->left = std::move(child->right);
+                child->right = std::move(node);
+                node = std::move(child);
+            } else {
+                // No left child: drop the node and continue down the right spine
+                node = std::move(node->right);
+            }
+        }
+    }
+};
+
+static_assert(sizeof(TreeNode<int>) == 3 * sizeof(void*), "height must stay in val's padding");
+
+// Arena-backed node: children are non-owning pointers into a NodeArena,
+// so a whole tree is released at once instead of one free() per node.
+template<typename T>
+struct ArenaTreeNode {
+    T val;
+    ArenaTreeNode<T>* left;
+    ArenaTreeNode<T>* right;
+
+    ArenaTreeNode(const T& x) : val(x), left(nullptr), right(nullptr) {}
+};
+
+enum class HugePages { transparent, explicit_2m, explicit_1g };
+enum class NumaPlacement { first_touch, interleave, bind };
+
+struct HugePageOptions {
+    // transparent: THP via madvise(MADV_HUGEPAGE), needs no setup.
+    // explicit_*: MAP_HUGETLB from the reserved pool (vm.nr_hugepages or
+    // hugepagesz=1G at boot); falls back to THP when the pool is empty.
+    HugePages pages = HugePages::transparent;
+    // first_touch leaves placement to the kernel (the node of the thread
+    // that first writes a page); interleave spreads pages round-robin over
+    // all nodes; bind keeps them on `node`
+    NumaPlacement numa = NumaPlacement::first_touch;
+    int node = 0;
+
+    bool operator==(const HugePageOptions&) const = default;
+};
+
+// Allocator for multi-GB buffers (NodeArena blocks, EytzingerTree keys,
+// search inputs) that backs them with 2M/1G pages so the page walk stops
+// dominating random access, and optionally pins or interleaves them across
+// NUMA nodes. Each allocation is its own mapping, aligned to the huge page
+// size; requests smaller than half a huge page go to operator new, since
+// rounding them up would waste most of the page. Give NodeArena a large
+// block_nodes so its blocks qualify.
+template<typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    explicit HugePageAllocator(HugePageOptions options) : options_(options) {}
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) : options_(other.options()) {}
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        if (bytes < page_size() / 2) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+        }
+        return static_cast<T*>(map(round_up(bytes)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (bytes < page_size() / 2) {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+            return;
+        }
+        ::munmap(p, round_up(bytes));
+    }
+
+    const HugePageOptions& options() const { return options_; }
+
+    template<typename U>
+    bool operator==(const HugePageAllocator<U>& other) const { return options_ == other.options(); }
+
+private:
+    size_t page_size() const {
+        return options_.pages == HugePages::explicit_1g ? size_t{1} << 30 : size_t{1} << 21;
+    }
+
+    size_t round_up(size_t bytes) const { return (bytes + page_size() - 1) & ~(page_size() - 1); }
+
+    void* map(size_t bytes) const {
+        const int prot = PROT_READ | PROT_WRITE;
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        void* p = MAP_FAILED;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+        if (options_.pages != HugePages::transparent) {
+            const int shift = options_.pages == HugePages::explicit_1g ? 30 : 21;
+            p = ::mmap(nullptr, bytes, prot, flags | MAP_HUGETLB | (shift << MAP_HUGE_SHIFT), -1, 0);
+        }
+#endif
+        if (p == MAP_FAILED) {
+            // Over-map by one huge page and trim, so THP can use whole
+            // aligned 2M extents from the first byte
+            const size_t align = page_size();
+            void* raw = ::mmap(nullptr, bytes + align, prot, flags, -1, 0);
+            if (raw == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            const auto start = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = (start + align - 1) & ~(align - 1);
+            if (aligned > start) {
+                ::munmap(raw, aligned - start);
+            }
+            if (const size_t tail = start + bytes + align - (aligned + bytes)) {
+                ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+            }
+            p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+            ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+        }
+        try {
+            place(p, bytes);
+        } catch (...) {
+            ::munmap(p, bytes);
+            throw;
+        }
+        return p;
+    }
+
+    // Set the NUMA policy before any page is touched. The mask is built
+    // from the nodes this thread may allocate on (cpusets included), so
+    // interleave covers exactly those. Throws std::system_error when the
+    // kernel refuses the policy, or when the platform has no mbind, rather
+    // than handing out memory placed some other way.
+    void place(void* p, size_t bytes) const {
+        if (options_.numa == NumaPlacement::first_touch) {
+            return;
+        }
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+        constexpr size_t kMaxNodes = 1024; // MAX_NUMNODES of the largest kernel configs
+        constexpr size_t kBits = 8 * sizeof(unsigned long);
+        unsigned long allowed[kMaxNodes / kBits] = {};
+        if (::syscall(SYS_get_mempolicy, nullptr, allowed, kMaxNodes, nullptr, MPOL_F_MEMS_ALLOWED) != 0) {
+            throw std::system_error(errno, std::generic_category(), "HugePageAllocator: get_mempolicy");
+        }
+
+        unsigned long mask[kMaxNodes / kBits] = {};
+        int mode = MPOL_INTERLEAVE;
+        if (options_.numa == NumaPlacement::interleave) {
+            std::copy(std::begin(allowed), std::end(allowed), std::begin(mask));
+        } else {
+            const size_t node = static_cast<size_t>(options_.node);
+            if (options_.node < 0 || node >= kMaxNodes || !(allowed[node / kBits] >> (node % kBits) & 1)) {
+                throw std::system_error(EINVAL, std::generic_category(),
+                                        "HugePageAllocator: node " + std::to_string(options_.node) + " is not allowed");
+            }
+            mode = MPOL_BIND;
+            mask[node / kBits] = 1ul << (node % kBits);
+        }
+
+        // maxnode counts bits and the kernel reads one fewer than it is
+        // given, so pass highest node + 2
+        size_t highest = 0;
+        for (size_t node = 0; node < kMaxNodes; ++node) {
+            if (mask[node / kBits] >> (node % kBits) & 1) {
+                highest = node;
+            }
+        }
+        if (::syscall(SYS_mbind, p, bytes, mode, mask, highest + 2, 0) != 0) {
+            throw std::system_error(errno, std::generic_category(), "HugePageAllocator: mbind");
+        }
+#else
+        (void)p;
+        (void)bytes;
+        throw std::system_error(std::make_error_code(std::errc::function_not_supported),
+                                "HugePageAllocator: NUMA placement");
+#endif
+    }
+
+    HugePageOptions options_;
+};
+
+// Bump allocator that carves nodes out of large contiguous blocks.
+// Node addresses stay stable for the lifetime of the arena. Releasing the
+// arena frees every block in one go; destructors only run when T needs them.
+template<typename T, typename Allocator = std::allocator<ArenaTreeNode<T>>>
+class NodeArena {
+public:
+    using Node = ArenaTreeNode<T>;
+
+    explicit NodeArena(size_t block_nodes = 4096, const Allocator& alloc = Allocator())
+        : alloc_(alloc), block_nodes_(block_nodes == 0 ? 1 : block_nodes) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    ~NodeArena() { release(); }
+
+    // Make sure the next `count` nodes come from one contiguous block
+    void reserve(size_t count) {
+        if (blocks_.empty() || blocks_.back().capacity - blocks_.back().used < count) {
+            add_block(count);
+        }
+    }
+
+    // Contiguous storage for `count` nodes. The slots count as live at once
+    // and release() destroys them, so the caller must construct every slot
+    // (e.g. with std::construct_at) before the arena is released. If that
+    // construction can fail, destroy whatever was constructed and hand the
+    // slots back with deallocate_last before letting the exception escape.
+    Node* allocate(size_t count) {
+        reserve(count);
+        Block& block = blocks_.back();
+        Node* slots = block.data + block.used;
+        block.used += count;
+        size_ += count;
+        return slots;
+    }
+
+    // Undo the most recent allocate(count), whose slots hold no live nodes
+    void deallocate_last(Node* slots, size_t count) {
+        Block& block = blocks_.back();
+        if (slots + count != block.data + block.used || count > block.used) {
+            throw std::invalid_argument("NodeArena::deallocate_last: not the most recent allocation");
+        }
+        block.used -= count;
+        size_ -= count;
+    }
+
+    // The slot only counts as used once the constructor has returned, so a
+    // throwing T leaves the arena as it was
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        reserve(1);
+        Block& block = blocks_.back();
+        Node* node = std::construct_at(block.data + block.used, std::forward<Args>(args)...);
+        ++block.used;
+        ++size_;
+        return node;
+    }
+
+    // Free every node at once
+    void release() {
+        for (Block& block : blocks_) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy_n(block.data, block.used);
+            }
+            std::allocator_traits<Allocator>::deallocate(alloc_, block.data, block.capacity);
+        }
+        blocks_.clear();
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    struct Block {
+        Node* data;
+        size_t capacity;
+        size_t used;
+    };
+
+    void add_block(size_t min_count) {
+        size_t capacity = min_count > block_nodes_ ? min_count : block_nodes_;
+        blocks_.reserve(blocks_.size() + 1); // so the push_back below cannot throw and leak the block
+        Node* data = std::allocator_traits<Allocator>::allocate(alloc_, capacity);
+        blocks_.push_back({data, capacity, 0});
+    }
+
+    Allocator alloc_;
+    size_t block_nodes_;
+    size_t size_ = 0;
+    std::vector<Block> blocks_;
+};
+
+// Child link accessors so traversal helpers work on both node flavours
+template<typename T>
+const TreeNode<T>* childPtr(const std::unique_ptr<TreeNode<T>>& link) { return link.get(); }
+
+template<typename T>
+const ArenaTreeNode<T>* childPtr(const ArenaTreeNode<T>* link) { return link; }
+
+// Iterative in-order walk; stack memory is bounded by tree height, not call depth
+template<typename Node, typename Visit>
+void inorderVisit(const Node* root, Visit visit) {
+    std::vector<const Node*> stack;
+    const Node* curr = root;
+    while (curr != nullptr || !stack.empty()) {
+        while (curr != nullptr) {
+            stack.push_back(curr);
+            curr = childPtr(curr->left);
+        }
+        curr = stack.back();
+        stack.pop_back();
+        visit(curr->val);
+        curr = childPtr(curr->right);
+    }
+}
+
+// Lazy sequence produced by a coroutine (std::generator is C++23 and not in
+// every standard library yet). Each co_yield hands out a reference to a
+// value that stays alive while the coroutine is suspended, typically a key
+// inside the tree, so nothing is copied or collected. It is an input view:
+// range-for, std::views::take/filter/... and early exit all work, and
+// destroying the generator mid-way releases the coroutine frame. The frame
+// itself is not elided: the generator outlives the call that creates it,
+// so each traversal costs one operator new for the frame on top of its
+// stack vector.
+template<typename T>
+class Generator : public std::ranges::view_interface<Generator<T>> {
+public:
+    struct promise_type {
+        const T* current = nullptr;
+        std::exception_ptr error;
+
+        Generator get_return_object() { return Generator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(Handle handle) : handle_(handle) {}
+
+        const T& operator*() const { return *handle_.promise().current; }
+        iterator& operator++() {
+            resume(handle_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.handle_.done(); }
+
+    private:
+        Handle handle_;
+    };
+
+    Generator(Generator&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~Generator() {
+        if (handle_) handle_.destroy();
+    }
+
+    // Single pass: begin() runs the coroutine to its first co_yield
+    iterator begin() {
+        resume(handle_);
+        return iterator(handle_);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    explicit Generator(Handle handle) : handle_(handle) {}
+
+    static void resume(Handle handle) {
+        handle.resume();
+        if (handle.promise().error) {
+            std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+        }
+    }
+
+    Handle handle_;
+};
+
+template<typename Node>
+using NodeValue = std::remove_cvref_t<decltype(std::declval<const Node&>().val)>;
+
+// Lazy traversals over either node flavour. Each keeps an explicit stack in
+// its coroutine frame: one frame per traversal, O(height) stack memory, O(1)
+// amortized work per key, and no recursion.
+template<typename Node>
+Generator<NodeValue<Node>> inorder(const Node* root) {
+    std::vector<const Node*> stack;
+    const Node* curr = root;
+    while (curr != nullptr || !stack.empty()) {
+        while (curr != nullptr) {
+            stack.push_back(curr);
+            curr = childPtr(curr->left);
+        }
+        curr = stack.back();
+        stack.pop_back();
+        co_yield curr->val;
+        curr = childPtr(curr->right);
+    }
+}
+
+template<typename Node>
+Generator<NodeValue<Node>> preorder(const Node* root) {
+    std::vector<const Node*> stack;
+    if (root) stack.push_back(root);
+    while (!stack.empty()) {
+        const Node* curr = stack.back();
+        stack.pop_back();
+        co_yield curr->val;
+        if (auto right = childPtr(curr->right)) stack.push_back(right);
+        if (auto left = childPtr(curr->left)) stack.push_back(left);
+    }
+}
+
+// Keys in [low, high], ascending. Subtrees entirely below low are never
+// entered and the walk stops at the first key above high, so the cost is
+// O(height + keys yielded). Bounds are taken by value: the coroutine
+// outlives the call expression.
+template<typename Node>
+Generator<NodeValue<Node>> inorderRange(const Node* root, NodeValue<Node> low, NodeValue<Node> high) {
+    std::vector<const Node*> stack;
+    const Node* curr = root;
+    while (curr != nullptr || !stack.empty()) {
+        while (curr != nullptr) {
+            if (curr->val < low) {
+                curr = childPtr(curr->right); // whole left subtree is below low
+            } else {
+                stack.push_back(curr);
+                curr = childPtr(curr->left);
+            }
+        }
+        if (stack.empty()) {
+            co_return; // everything that was left lies below low
+        }
+        curr = stack.back();
+        stack.pop_back();
+        if (high < curr->val) {
+            co_return;
+        }
+        co_yield curr->val;
+        curr = childPtr(curr->right);
+    }
+}
+
+// Pending child slots of an iterative pre-order build. Link is the child
+// pointer type (unique_ptr or raw arena pointer). A slot is an empty child
+// link plus the open interval its key must fall in; the top of the stack is
+// always the slot the recursive build would try next.
+template<Ordered T, typename Link>
+class PreorderSlots {
+public:
+    explicit PreorderSlots(Link& root) {
+        slots_.push_back({&root, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()});
+    }
+
+    // Attach make_node(val) at the slot it belongs to. Slots above it are
+    // closed, exactly like the recursive version returning nullptr on its way
+    // back up. Returns false and leaves the stack untouched if val fits no
+    // open slot (out of order, or a duplicate).
+    template<typename MakeNode>
+    bool place(const T& val, MakeNode& make_node) {
+        size_t open = slots_.size();
+        while (open > 0 && (val <= slots_[open - 1].lower_bound || val >= slots_[open - 1].upper_bound)) {
+            --open;
+        }
+        if (open == 0) {
+            return false;
+        }
+        slots_.resize(open);
+
+        Slot slot = std::move(slots_.back());
+        slots_.pop_back();
+
+        Link& node = *slot.link;
+        node = make_node(val);
+        // Right slot first so the left subtree is filled before it
+        slots_.push_back({&node->right, val, std::move(slot.upper_bound)});
+        slots_.push_back({&node->left, std::move(slot.lower_bound), val});
+        return true;
+    }
+
+    // Open slots; bounded by tree height, not by input size
+    size_t size() const { return slots_.size(); }
+
+private:
+    struct Slot {
+        Link* link;
+        T lower_bound;
+        T upper_bound;
+    };
+
+    std::vector<Slot> slots_;
 };
 
 template<Ordered T>
@@ -58,16 +603,985 @@ public:
         
         return node;
     }
+
+    // Iterative variant: same output as sortedArrayToBST, but the pending child
+    // slots live on an explicit heap stack instead of the call stack, so input
+    // size is not limited by recursion depth. Each key is pushed and popped once.
+    std::unique_ptr<TreeNode<T>> sortedArrayToBSTIterative(const std::vector<T>& nums) {
+        std::unique_ptr<TreeNode<T>> root;
+        buildIterative(nums, root, [](const T& val) { return std::make_unique<TreeNode<T>>(val); });
+        return root;
+    }
+
+    template<typename Allocator>
+    ArenaTreeNode<T>* sortedArrayToBSTIterative(const std::vector<T>& nums, NodeArena<T, Allocator>& arena) {
+        ArenaTreeNode<T>* root = nullptr;
+        arena.reserve(nums.size());
+        buildIterative(nums, root, [&arena](const T& val) { return arena.create(val); });
+        return root;
+    }
+
+    template<typename Link, typename MakeNode>
+    void buildIterative(const std::vector<T>& nums, Link& root, MakeNode make_node) {
+        PreorderSlots<T, Link> slots(root);
+        for (const T& val : nums) {
+            // Like the recursive build, stop at the first key that fits nowhere
+            if (!slots.place(val, make_node)) {
+                break;
+            }
+        }
+    }
+
+    // Arena variant: same pre-order construction, but every node is carved
+    // out of `arena` and the tree is freed together with it
+    template<typename Allocator>
+    ArenaTreeNode<T>* sortedArrayToBST(const std::vector<T>& nums, NodeArena<T, Allocator>& arena) {
+        if (nums.empty()) return nullptr;
+        arena.reserve(nums.size());
+        int index = 0;
+        return build(nums, index, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(), arena);
+    }
+
+    template<typename Allocator>
+    ArenaTreeNode<T>* build(const std::vector<T>& nums, int& index, T lower_bound, T upper_bound,
+                            NodeArena<T, Allocator>& arena) {
+        if (index >= static_cast<int>(nums.size())) {
+            return nullptr;
+        }
+
+        T val = nums[static_cast<size_t>(index)];
+        if (val <= lower_bound || val >= upper_bound) {
+            return nullptr;
+        }
+        index++;
+
+        ArenaTreeNode<T>* node = arena.create(val);
+        node->left = build(nums, index, lower_bound, val, arena);
+        node->right = build(nums, index, val, upper_bound, arena);
+        return node;
+    }
     
-    // Helper to print tree (Pre-order)
+    // Balanced build for input that really is sorted (sortedArrayToBST reads
+    // pre-order, so sorted input there becomes a right-leaning chain). Every
+    // range's midpoint is its root, giving height ceil(log2(n + 1)). All
+    // nodes come from one contiguous arena block where key i lives in slot i,
+    // so the layout is in-order. Ranges of at least kParallelCutoff keys
+    // build their left half on another thread while this one builds the
+    // right half, up to `threads` threads in total. Throws
+    // std::invalid_argument unless the keys are strictly ascending; the
+    // check is folded into node construction, so it runs in parallel too.
+    // On any exception (including one from T's copy constructor on a worker
+    // thread) the arena is left as it was.
+    template<typename Allocator>
+    ArenaTreeNode<T>* sortedArrayToBalancedBST(const std::vector<T>& sorted, NodeArena<T, Allocator>& arena,
+                                               unsigned threads = std::thread::hardware_concurrency()) {
+        if (sorted.empty()) return nullptr;
+        ArenaTreeNode<T>* slots = arena.allocate(sorted.size());
+        std::atomic<bool> unsorted{false};
+        ArenaTreeNode<T>* root = nullptr;
+        try {
+            root = buildBalanced(sorted, slots, 0, sorted.size(),
+                                 static_cast<unsigned>(std::bit_width(std::max(threads, 1u)) - 1), unsorted);
+        } catch (...) {
+            arena.deallocate_last(slots, sorted.size());
+            throw;
+        }
+        if (unsorted.load()) {
+            std::destroy_n(slots, sorted.size());
+            arena.deallocate_last(slots, sorted.size());
+            throw std::invalid_argument("sortedArrayToBalancedBST: keys must be strictly ascending");
+        }
+        return root;
+    }
+
+    static constexpr size_t kParallelCutoff = size_t{1} << 15;
+
+    // Builds [first, last) into slots[first, last); `split_depth` more levels
+    // may still fork. Returns the subtree root. Either every slot in the
+    // range ends up constructed or, if a copy throws, none does: the halves
+    // that did finish are destroyed before the first exception is rethrown
+    // on the calling thread.
+    ArenaTreeNode<T>* buildBalanced(const std::vector<T>& sorted, ArenaTreeNode<T>* slots, size_t first, size_t last,
+                                    unsigned split_depth, std::atomic<bool>& unsorted) {
+        if (first == last) return nullptr;
+        const size_t mid = first + (last - first) / 2;
+        ArenaTreeNode<T>* node = std::construct_at(slots + mid, sorted[mid]);
+        if (mid > 0 && !(sorted[mid - 1] < sorted[mid])) {
+            unsorted.store(true, std::memory_order_relaxed);
+        }
+
+        const unsigned child_depth = last - first >= kParallelCutoff ? split_depth : 0;
+        std::exception_ptr left_error, right_error;
+        bool right_built = false;
+        {
+            std::jthread left;
+            auto build_left = [&] {
+                try {
+                    node->left = buildBalanced(sorted, slots, first, mid, child_depth - (child_depth > 0), unsorted);
+                } catch (...) {
+                    left_error = std::current_exception();
+                }
+            };
+            if (child_depth > 0) {
+                left = std::jthread(build_left);
+            } else {
+                build_left();
+            }
+            // a sequential build stops at the first failure; a forked one
+            // must not read left_error before the join
+            if (child_depth > 0 || !left_error) {
+                try {
+                    node->right = buildBalanced(sorted, slots, mid + 1, last, child_depth - (child_depth > 0), unsorted);
+                    right_built = true;
+                } catch (...) {
+                    right_error = std::current_exception();
+                }
+            }
+        }
+        if (left_error || right_error) {
+            if (!left_error) std::destroy(slots + first, slots + mid);
+            if (right_built) std::destroy(slots + mid + 1, slots + last);
+            std::destroy_at(node);
+            std::rethrow_exception(left_error ? left_error : right_error);
+        }
+        return node;
+    }
+
+    // Helper to print tree (Pre-order); walks lazily via the preorder()
+    // generator, so degenerate trees do not recurse once per level
     void printTree(const std::unique_ptr<TreeNode<T>>& node) {
-        if (!node) return;
-        std::cout << node->val << " ";
-        printTree(node->left);
-        printTree(node->right);
+        printTree(node.get());
+    }
+
+    void printTree(const TreeNode<T>* node) {
+        for (const T& val : preorder(node)) {
+            std::cout << val << " ";
+        }
+    }
+
+    void printTree(const ArenaTreeNode<T>* node) {
+        for (const T& val : preorder(node)) {
+            std::cout << val << " ";
+        }
+    }
+};
+
+// Incrementally updated tree on the same TreeNode<T> links, kept AVL
+// balanced: subtree heights differ by at most one, so insert, erase and find
+// are O(log n) worst case whatever order keys arrive in (sorted input no
+// longer turns into a list). Recursion depth is bounded by the AVL height,
+// about 1.44 log2(n).
+template<Ordered T>
+class BalancedBST {
+    using Link = std::unique_ptr<TreeNode<T>>;
+
+public:
+    BalancedBST() = default;
+
+    // Returns false if val was already present
+    bool insert(const T& val) {
+        bool inserted = insert(root_, val);
+        size_ += inserted;
+        return inserted;
+    }
+
+    // Returns false if val was not present
+    bool erase(const T& val) {
+        bool erased = erase(root_, val);
+        size_ -= erased;
+        return erased;
+    }
+
+    const T* find(const T& target) const {
+        const TreeNode<T>* node = root_.get();
+        while (node) {
+            if (target < node->val) {
+                node = node->left.get();
+            } else if (node->val < target) {
+                node = node->right.get();
+            } else {
+                return &node->val;
+            }
+        }
+        return nullptr;
+    }
+
+    bool contains(const T& target) const { return find(target) != nullptr; }
+
+    size_t size() const { return size_; }
+    int height() const { return heightOf(root_); }
+    const Link& root() const { return root_; }
+
+    // Hand the tree over, e.g. to ConcurrentBST::publish or EytzingerTree
+    Link release() {
+        size_ = 0;
+        return std::move(root_);
+    }
+
+private:
+    static int heightOf(const Link& node) { return node ? node->height : 0; }
+
+    static void updateHeight(TreeNode<T>& node) {
+        node.height = static_cast<uint8_t>(1 + std::max(heightOf(node.left), heightOf(node.right)));
+    }
+
+    static void rotateRight(Link& node) {
+        Link child = std::move(node->left);
+        node->left = std::move(child->right);
+        updateHeight(*node);
+        child->right = std::move(node);
+        node = std::move(child);
+        updateHeight(*node);
+    }
+
+    static void rotateLeft(Link& node) {
+        Link child = std::move(node->right);
+        node->right = std::move(child->left);
+        updateHeight(*node);
+        child->left = std::move(node);
+        node = std::move(child);
+        updateHeight(*node);
+    }
+
+    // Restore the AVL invariant at node after one of its subtrees changed
+    // height by one
+    static void rebalance(Link& node) {
+        updateHeight(*node);
+        const int balance = heightOf(node->left) - heightOf(node->right);
+        if (balance > 1) {
+            if (heightOf(node->left->left) < heightOf(node->left->right)) {
+                rotateLeft(node->left); // left-right case
+            }
+            rotateRight(node);
+        } else if (balance < -1) {
+            if (heightOf(node->right->right) < heightOf(node->right->left)) {
+                rotateRight(node->right); // right-left case
+            }
+            rotateLeft(node);
+        }
+    }
+
+    static bool insert(Link& node, const T& val) {
+        if (!node) {
+            node = std::make_unique<TreeNode<T>>(val);
+            return true;
+        }
+        bool inserted;
+        if (val < node->val) {
+            inserted = insert(node->left, val);
+        } else if (node->val < val) {
+            inserted = insert(node->right, val);
+        } else {
+            return false;
+        }
+        if (inserted) rebalance(node);
+        return inserted;
+    }
+
+    // Unlink the smallest node of a non-empty subtree
+    static Link detachMin(Link& node) {
+        if (!node->left) {
+            Link min = std::move(node);
+            node = std::move(min->right);
+            return min;
+        }
+        Link min = detachMin(node->left);
+        rebalance(node);
+        return min;
+    }
+
+    static bool erase(Link& node, const T& val) {
+        if (!node) {
+            return false;
+        }
+        if (val < node->val) {
+            if (!erase(node->left, val)) return false;
+        } else if (node->val < val) {
+            if (!erase(node->right, val)) return false;
+        } else if (!node->left) {
+            node = std::move(node->right);
+        } else if (!node->right) {
+            node = std::move(node->left);
+        } else {
+            // Two children: the in-order successor takes this node's place
+            Link successor = detachMin(node->right);
+            successor->left = std::move(node->left);
+            successor->right = std::move(node->right);
+            node = std::move(successor);
+        }
+        if (node) rebalance(node);
+        return true;
+    }
+
+    Link root_;
+    size_t size_ = 0;
+};
+
+// Push-based pre-order builder: keys arrive in chunks (from a socket, a
+// file reader, ...) and are linked into the tree as they come, so the input
+// never has to be materialized. Memory is the tree plus O(height) open slots.
+// Unlike sortedArrayToBST, which silently stops at the first key that does
+// not fit, feed() rejects such a key as soon as it arrives.
+template<Ordered T>
+class StreamingBSTBuilder {
+public:
+    StreamingBSTBuilder() : slots_(root_) {}
+
+    StreamingBSTBuilder(const StreamingBSTBuilder&) = delete;
+    StreamingBSTBuilder& operator=(const StreamingBSTBuilder&) = delete;
+
+    // Throws std::invalid_argument naming the first key that is not a valid
+    // continuation of the pre-order sequence; keys before it stay in the
+    // tree and the builder can still be fed or finished.
+    void feed(std::span<const T> keys) {
+        auto make_node = [](const T& val) { return std::make_unique<TreeNode<T>>(val); };
+        for (const T& val : keys) {
+            if (!slots_.place(val, make_node)) {
+                throw std::invalid_argument("StreamingBSTBuilder: key at position " + std::to_string(count_) +
+                                            " does not continue a valid pre-order sequence");
+            }
+            ++count_;
+        }
+    }
+
+    // Keys consumed so far
+    size_t size() const { return count_; }
+
+    // Hand over the tree and start again from empty
+    std::unique_ptr<TreeNode<T>> finish() {
+        std::unique_ptr<TreeNode<T>> tree = std::move(root_);
+        slots_ = PreorderSlots<T, std::unique_ptr<TreeNode<T>>>(root_);
+        count_ = 0;
+        return tree;
+    }
+
+private:
+    std::unique_ptr<TreeNode<T>> root_;
+    PreorderSlots<T, std::unique_ptr<TreeNode<T>>> slots_;
+    size_t count_ = 0;
+};
+
+// Eytzinger descents end below the answer: strip the trailing right turns
+// plus the last left turn to get back to that node (0 = past the end)
+constexpr size_t eytzingerDecode(size_t k) { return k >> (std::countr_one(k) + 1); }
+
+#if defined(__x86_64__) || defined(__i386__)
+// Eight Eytzinger descents at once: gather the current node of every lane,
+// compare, and step to 2k or 2k+1. Lanes that fell off the tree keep
+// appending right turns, which the caller's decode strips again.
+__attribute__((target("avx2")))
+void eytzingerDescendAvx2(const int32_t* keys, size_t n, const int32_t* targets, size_t count, size_t* slots) {
+    const int levels = std::bit_width(n);
+    const __m256i n_vec = _mm256_set1_epi32(static_cast<int32_t>(n));
+    const __m256i one = _mm256_set1_epi32(1);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i target = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(targets + i));
+        __m256i k = one;
+        for (int level = 0; level < levels; ++level) {
+            __m256i past_end = _mm256_cmpgt_epi32(k, n_vec);
+            __m256i idx = _mm256_min_epi32(k, n_vec);
+            __m256i key = _mm256_i32gather_epi32(keys, idx, 4);
+            __m256i go_right = _mm256_or_si256(past_end, _mm256_cmpgt_epi32(target, key));
+            // go_right lanes are -1, so subtracting adds the right-turn bit
+            k = _mm256_sub_epi32(_mm256_add_epi32(k, k), go_right);
+        }
+        alignas(32) uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), k);
+        for (int lane = 0; lane < 8; ++lane) {
+            slots[i + lane] = lanes[lane];
+        }
+    }
+}
+#endif
+
+// Read-only snapshot of a BST in Eytzinger (BFS) order: slot k has children
+// 2k and 2k+1, so the top levels share a handful of cache lines and a lookup
+// is a branchless descent instead of a chain of dependent pointer loads.
+// In-order keys of the source tree must be strictly increasing (a valid BST).
+template<Ordered T, typename Allocator = std::allocator<T>>
+class EytzingerTree {
+public:
+    explicit EytzingerTree(const std::unique_ptr<TreeNode<T>>& root, const Allocator& alloc = Allocator())
+        : keys_(alloc) { freeze(root.get()); }
+
+    explicit EytzingerTree(const ArenaTreeNode<T>* root, const Allocator& alloc = Allocator())
+        : keys_(alloc) { freeze(root); }
+
+    size_t size() const { return keys_.size() - 1; }
+
+    // Slot of the first key not less than target, or 0 if every key is smaller
+    size_t lower_bound_slot(const T& target) const {
+        const size_t n = size();
+        const T* keys = keys_.data();
+        size_t k = 1;
+        while (k <= n) {
+            // kPrefetchLevels ahead: the kPrefetchStride descendants there
+            // are contiguous, about one cache line (4 levels for 4-byte keys)
+            __builtin_prefetch(keys + std::min(k * kPrefetchStride, n));
+            k = 2 * k + (keys[k] < target);
+        }
+        return decode(k);
+    }
+
+    const T* find(const T& target) const {
+        size_t slot = lower_bound_slot(target);
+        if (slot == 0 || target < keys_[slot]) return nullptr;
+        return &keys_[slot];
+    }
+
+    bool contains(const T& target) const { return find(target) != nullptr; }
+
+    // Batched membership test. The descents are interleaved so independent
+    // cache misses overlap; 32-bit int keys use AVX2 gathers when available.
+    // Throws std::invalid_argument if out is shorter than targets.
+    void contains_many(std::span<const T> targets, std::span<bool> out) const {
+        if (out.size() < targets.size()) {
+            throw std::invalid_argument("EytzingerTree::contains_many: out is shorter than targets");
+        }
+        constexpr size_t kBatch = 16;
+        const size_t n = size();
+        const T* keys = keys_.data();
+        size_t slots[kBatch];
+
+        for (size_t base = 0; base < targets.size(); base += kBatch) {
+            const size_t count = std::min(kBatch, targets.size() - base);
+            size_t done = 0;
+#if defined(__x86_64__) || defined(__i386__)
+            if constexpr (std::is_same_v<T, int32_t>) {
+                if (n < (size_t{1} << 30) && __builtin_cpu_supports("avx2")) {
+                    eytzingerDescendAvx2(keys, n, targets.data() + base, count, slots);
+                    done = count - count % 8;
+                }
+            }
+#endif
+            for (size_t i = done; i < count; ++i) {
+                slots[i] = 1;
+            }
+            // Every lane runs the full height; past-the-end lanes turn right
+            for (int level = 0, levels = std::bit_width(n); level < levels; ++level) {
+                for (size_t i = done; i < count; ++i) {
+                    size_t k = slots[i];
+                    bool go_right = k > n || keys[k] < targets[base + i];
+                    slots[i] = 2 * k + go_right;
+                }
+            }
+            for (size_t i = 0; i < count; ++i) {
+                size_t slot = decode(slots[i]);
+                out[base + i] = slot != 0 && !(targets[base + i] < keys[slot]);
+            }
+        }
+    }
+
+private:
+    // Keys per 64-byte line, rounded down to a power of two so that
+    // k * kPrefetchStride is the first descendant kPrefetchLevels below k
+    static constexpr size_t kPrefetchStride = std::bit_floor(std::max<size_t>(64 / sizeof(T), 1));
+    static constexpr int kPrefetchLevels = std::countr_zero(kPrefetchStride);
+
+    static size_t decode(size_t k) { return eytzingerDecode(k); }
+
+    template<typename Node>
+    void freeze(const Node* root) {
+        size_t n = 0;
+        inorderVisit(root, [&n](const T&) { ++n; });
+        if (n == 0) {
+            keys_.resize(1);
+            return;
+        }
+
+        // Slot 0 is padding so children of k are exactly 2k and 2k+1
+        keys_.resize(n + 1, root->val);
+
+        // Walk the implicit tree in-order alongside the real one
+        size_t k = 1;
+        while (2 * k <= n) k *= 2;
+        inorderVisit(root, [&](const T& val) {
+            keys_[k] = val;
+            if (2 * k + 1 <= n) {
+                k = 2 * k + 1;
+                while (2 * k <= n) k *= 2;
+            } else {
+                while (k & 1) k >>= 1;
+                k >>= 1;
+            }
+        });
+    }
+
+    std::vector<T, Allocator> keys_;
+};
+
+// Compile-time frozen BST for constant key sets (opcode maps, enum-to-name
+// tables). The constexpr constructor sorts the entries and lays them out in
+// Eytzinger order, so a `constexpr StaticBSTMap` is baked into .rodata;
+// startup does no work and lookups inline to a few compares.
+template<Ordered Key, typename Value, size_t N>
+class StaticBSTMap {
+public:
+    constexpr StaticBSTMap(std::array<std::pair<Key, Value>, N> entries) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (size_t i = 1; i < N; ++i) {
+            if (!(entries[i - 1].first < entries[i].first)) {
+                // Not a constant expression: duplicate keys fail to compile
+                throw "StaticBSTMap: duplicate key";
+            }
+        }
+
+        // Same implicit in-order walk as EytzingerTree::freeze
+        size_t k = 1;
+        while (2 * k <= N) k *= 2;
+        for (const auto& entry : entries) {
+            keys_[k] = entry.first;
+            values_[k] = entry.second;
+            if (2 * k + 1 <= N) {
+                k = 2 * k + 1;
+                while (2 * k <= N) k *= 2;
+            } else {
+                while (k & 1) k >>= 1;
+                k >>= 1;
+            }
+        }
+    }
+
+    static constexpr size_t size() { return N; }
+
+    // Value stored for key, or nullptr
+    constexpr const Value* find(const Key& key) const {
+        size_t k = 1;
+        while (k <= N) {
+            k = 2 * k + (keys_[k] < key);
+        }
+        k = eytzingerDecode(k);
+        if (k == 0 || key < keys_[k]) return nullptr;
+        return &values_[k];
+    }
+
+    constexpr bool contains(const Key& key) const { return find(key) != nullptr; }
+
+private:
+    // Slot 0 is padding so children of k are 2k and 2k+1
+    std::array<Key, N + 1> keys_{};
+    std::array<Value, N + 1> values_{};
+};
+
+template<typename Key, typename Value, size_t N>
+StaticBSTMap(std::array<std::pair<Key, Value>, N>) -> StaticBSTMap<Key, Value, N>;
+
+// Example table: built entirely by the compiler
+constexpr StaticBSTMap opcode_names(std::array<std::pair<int, std::string_view>, 6>{{
+    {0x90, "nop"}, {0x01, "add"}, {0xC3, "ret"}, {0x29, "sub"}, {0xE8, "call"}, {0xEB, "jmp"},
+}});
+
+static_assert(opcode_names.contains(0xC3) && !opcode_names.contains(0x00),
+              "lookups work in constant expressions");
+
+// On-disk snapshot format, version 1 (native byte order):
+//   SnapshotHeader, then node_count SnapshotNode<T> records in pre-order.
+// Children are record indices (kSnapshotNoChild for none), so a mapped file
+// is queried in place; the checksum covers the node records only.
+inline constexpr std::array<char, 8> kSnapshotMagic = {'C', 'S', 'B', 'S', 'T', 'S', 'N', 'P'};
+inline constexpr uint32_t kSnapshotVersion = 1;
+inline constexpr uint32_t kSnapshotNoChild = UINT32_MAX;
+
+struct SnapshotHeader {
+    std::array<char, 8> magic;
+    uint32_t version;     // a big-endian reader sees an unknown version
+    uint32_t key_size;    // sizeof(T), rejects a mismatched key type
+    uint64_t node_count;
+    uint64_t checksum;
+    uint32_t root;
+    uint32_t node_size;   // sizeof(SnapshotNode<T>), including padding
+};
+
+template<typename T>
+struct SnapshotNode {
+    T val;
+    uint32_t left;
+    uint32_t right;
+};
+
+// FNV-1a over 64-bit words; a short tail is zero-padded
+inline uint64_t snapshotChecksum(const void* data, size_t bytes) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < bytes; i += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, p + i, std::min<size_t>(8, bytes - i));
+        hash = (hash ^ word) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// Flatten a tree (either node flavour) into a snapshot file
+template<typename Node>
+void writeSnapshot(const Node* root, const std::string& path) {
+    using T = std::remove_cvref_t<decltype(root->val)>;
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot keys are stored as raw bytes");
+
+    // Value-initialized records have zeroed padding, so checksums are stable
+    std::vector<SnapshotNode<T>> nodes;
+    struct Pending { const Node* node; size_t parent; bool is_right; };
+    std::vector<Pending> stack;
+    if (root) stack.push_back({root, SIZE_MAX, false});
+    while (!stack.empty()) {
+        Pending p = stack.back();
+        stack.pop_back();
+        if (nodes.size() >= kSnapshotNoChild) {
+            throw std::length_error("writeSnapshot: too many nodes for 32-bit indices");
+        }
+        const auto index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        nodes.back().val = p.node->val;
+        nodes.back().left = nodes.back().right = kSnapshotNoChild;
+        if (p.parent != SIZE_MAX) {
+            (p.is_right ? nodes[p.parent].right : nodes[p.parent].left) = index;
+        }
+        if (auto right = childPtr(p.node->right)) stack.push_back({right, index, true});
+        if (auto left = childPtr(p.node->left)) stack.push_back({left, index, false});
+    }
+
+    const size_t bytes = nodes.size() * sizeof(SnapshotNode<T>);
+    SnapshotHeader header{kSnapshotMagic, kSnapshotVersion, sizeof(T), nodes.size(),
+                          snapshotChecksum(nodes.data(), bytes),
+                          nodes.empty() ? kSnapshotNoChild : 0, sizeof(SnapshotNode<T>)};
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(nodes.data()), static_cast<std::streamsize>(bytes));
+    if (!out) {
+        throw std::runtime_error("writeSnapshot: cannot write " + path);
+    }
+}
+
+// Read-only view of a memory-mapped snapshot. Opening checks the header and
+// the file size, which is O(1); nothing is parsed or copied. Node contents
+// are validated lazily: find() checks every node it visits (index range and
+// BST bounds along the path) and throws std::runtime_error on corruption,
+// while validate() / verify_checksum() do the full O(n) pass on demand.
+template<Ordered T>
+class SnapshotView {
+    using Node = SnapshotNode<T>;
+    static_assert(alignof(Node) <= alignof(SnapshotHeader), "records must stay aligned after the header");
+
+public:
+    explicit SnapshotView(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("SnapshotView: cannot open " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+            ::close(fd);
+            throw std::runtime_error("SnapshotView: " + path + " is too small");
+        }
+        bytes_ = static_cast<size_t>(st.st_size);
+        void* base = ::mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            throw std::runtime_error("SnapshotView: cannot map " + path);
+        }
+        base_ = base;
+
+        const auto& h = header();
+        const bool sizes_ok = h.key_size == sizeof(T) && h.node_size == sizeof(Node) &&
+                              h.node_count <= (bytes_ - sizeof(SnapshotHeader)) / sizeof(Node) &&
+                              bytes_ == sizeof(SnapshotHeader) + h.node_count * sizeof(Node);
+        const bool root_ok = h.node_count == 0 ? h.root == kSnapshotNoChild : h.root < h.node_count;
+        if (h.magic != kSnapshotMagic || h.version != kSnapshotVersion || !sizes_ok || !root_ok) {
+            unmap();
+            throw std::runtime_error("SnapshotView: " + path + " is not a compatible snapshot");
+        }
+        nodes_ = reinterpret_cast<const Node*>(static_cast<const char*>(base_) + sizeof(SnapshotHeader));
+    }
+
+    SnapshotView(SnapshotView&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)), bytes_(other.bytes_), nodes_(other.nodes_) {}
+
+    SnapshotView& operator=(SnapshotView&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            base_ = std::exchange(other.base_, nullptr);
+            bytes_ = other.bytes_;
+            nodes_ = other.nodes_;
+        }
+        return *this;
+    }
+
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+
+    ~SnapshotView() { unmap(); }
+
+    size_t size() const { return header().node_count; }
+
+    // Pointer to the stored key equal to target (into the mapping), or nullptr
+    const T* find(const T& target) const {
+        const T* lower = nullptr; // exclusive bounds inherited from the path
+        const T* upper = nullptr;
+        uint32_t index = header().root;
+        while (index != kSnapshotNoChild) {
+            const Node& node = at(index);
+            if ((lower && !(*lower < node.val)) || (upper && !(node.val < *upper))) {
+                throw std::runtime_error("SnapshotView: node out of BST order");
+            }
+            if (target < node.val) {
+                upper = &node.val;
+                index = node.left;
+            } else if (node.val < target) {
+                lower = &node.val;
+                index = node.right;
+            } else {
+                return &node.val;
+            }
+        }
+        return nullptr;
     }
+
+    bool contains(const T& target) const { return find(target) != nullptr; }
+
+    bool verify_checksum() const {
+        return snapshotChecksum(nodes_, size() * sizeof(Node)) == header().checksum;
+    }
+
+    // Full structural check: every record reachable exactly once and in BST
+    // order. Strict bounds also rule out cycles and shared children.
+    bool validate() const {
+        struct Pending { uint32_t index; const T* lower; const T* upper; };
+        std::vector<Pending> stack;
+        if (size() > 0) stack.push_back({header().root, nullptr, nullptr});
+        size_t visited = 0;
+        while (!stack.empty()) {
+            Pending p = stack.back();
+            stack.pop_back();
+            if (p.index >= size()) return false;
+            const Node& node = nodes_[p.index];
+            if ((p.lower && !(*p.lower < node.val)) || (p.upper && !(node.val < *p.upper))) return false;
+            ++visited;
+            if (node.right != kSnapshotNoChild) stack.push_back({node.right, &node.val, p.upper});
+            if (node.left != kSnapshotNoChild) stack.push_back({node.left, p.lower, &node.val});
+        }
+        return visited == size();
+    }
+
+private:
+    const SnapshotHeader& header() const { return *static_cast<const SnapshotHeader*>(base_); }
+
+    const Node& at(uint32_t index) const {
+        if (index >= size()) {
+            throw std::runtime_error("SnapshotView: child index out of range");
+        }
+        return nodes_[index];
+    }
+
+    void unmap() {
+        if (base_) {
+            ::munmap(base_, bytes_);
+            base_ = nullptr;
+        }
+    }
+
+    void* base_ = nullptr;
+    size_t bytes_ = 0;
+    const Node* nodes_ = nullptr;
+};
+
+// Epoch-based reclamation shared by every ConcurrentBST. Each thread owns a
+// record where it announces the global epoch while it reads; retired memory
+// is freed once every announced epoch is newer than its retirement. Records
+// are claimed once per thread from a lock-free, append-only list and handed
+// back at thread exit.
+class EpochDomain {
+public:
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // Reader side: one store and no locks. Guards nest; the outermost one
+    // announces.
+    void enter() {
+        Record& r = local_record();
+        if (r.depth++ == 0) {
+            r.epoch.store(epoch_.load());
+        }
+    }
+
+    void exit() {
+        Record& r = local_record();
+        if (--r.depth == 0) {
+            r.epoch.store(kQuiescent);
+        }
+    }
+
+    // Writer side: call after unpublishing memory. Returns the epoch that
+    // every reader must have reached before that memory can be freed.
+    uint64_t advance() { return epoch_.fetch_add(1) + 1; }
+
+    // Oldest epoch any thread is reading under (UINT64_MAX if none)
+    uint64_t oldest_active() const {
+        uint64_t oldest = kQuiescent;
+        for (const Record* r = records_.load(); r != nullptr; r = r->next) {
+            oldest = std::min(oldest, r->epoch.load());
+        }
+        return oldest;
+    }
+
+private:
+    static constexpr uint64_t kQuiescent = UINT64_MAX;
+
+    // One cache line each so announcing never bounces a neighbour's line
+    struct alignas(64) Record {
+        std::atomic<uint64_t> epoch{kQuiescent};
+        std::atomic<bool> in_use{true};
+        unsigned depth = 0; // owner thread only
+        Record* next = nullptr;
+    };
+
+    // Returns the record to the pool when its thread exits
+    struct RecordLease {
+        Record* record;
+        ~RecordLease() { record->in_use.store(false); }
+    };
+
+    EpochDomain() = default;
+
+    Record& local_record() {
+        thread_local RecordLease lease{claim()};
+        return *lease.record;
+    }
+
+    Record* claim() {
+        for (Record* r = records_.load(); r != nullptr; r = r->next) {
+            bool free = false;
+            if (!r->in_use.load() && r->in_use.compare_exchange_strong(free, true)) {
+                return r;
+            }
+        }
+        // Records are never freed, so the list can only grow
+        auto* r = new Record;
+        r->next = records_.load();
+        while (!records_.compare_exchange_weak(r->next, r)) {
+        }
+        return r;
+    }
+
+    std::atomic<uint64_t> epoch_{1};
+    std::atomic<Record*> records_{nullptr};
+};
+
+// Read-mostly tree shared between threads. Readers take a Snapshot: an
+// epoch guard plus the current version, so lookups never lock or wait, even
+// while a writer rebuilds. Writers build the next tree off to the side and
+// publish it with one atomic pointer swap; the old version is freed only when
+// no snapshot can still see it. Writers are serialized among themselves.
+template<Ordered T>
+class ConcurrentBST {
+    struct Version {
+        std::unique_ptr<TreeNode<T>> root;
+        uint64_t number;
+    };
+
+public:
+    // Keeps one version alive; cheap to take, meant to be short-lived
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& other) noexcept : version_(std::exchange(other.version_, nullptr)) {}
+        Snapshot& operator=(Snapshot&&) = delete;
+        Snapshot(const Snapshot&) = delete;
+        ~Snapshot() {
+            if (version_) EpochDomain::instance().exit();
+        }
+
+        const TreeNode<T>* root() const { return version_->root.get(); }
+        uint64_t version() const { return version_->number; }
+
+        const T* find(const T& target) const {
+            const TreeNode<T>* node = root();
+            while (node) {
+                if (target < node->val) {
+                    node = node->left.get();
+                } else if (node->val < target) {
+                    node = node->right.get();
+                } else {
+                    return &node->val;
+                }
+            }
+            return nullptr;
+        }
+
+        bool contains(const T& target) const { return find(target) != nullptr; }
+
+    private:
+        friend class ConcurrentBST;
+        explicit Snapshot(const std::atomic<Version*>& current) {
+            // Announce first, then load: a writer that misses the announcement
+            // has already swapped, so this load sees the new version
+            EpochDomain::instance().enter();
+            version_ = current.load();
+        }
+
+        const Version* version_;
+    };
+
+    explicit ConcurrentBST(std::unique_ptr<TreeNode<T>> root = nullptr)
+        : current_(new Version{std::move(root), 0}) {}
+
+    ConcurrentBST(const ConcurrentBST&) = delete;
+    ConcurrentBST& operator=(const ConcurrentBST&) = delete;
+
+    // No snapshot may outlive the tree
+    ~ConcurrentBST() {
+        delete current_.load();
+        for (auto& r : retired_) delete r.version;
+    }
+
+    Snapshot snapshot() const { return Snapshot(current_); }
+
+    bool contains(const T& target) const { return snapshot().contains(target); }
+
+    // Swap in a new tree; readers holding a snapshot keep the old one
+    void publish(std::unique_ptr<TreeNode<T>> root) {
+        std::lock_guard lock(writer_);
+        auto* next = new Version{std::move(root), current_.load()->number + 1};
+        Version* old = current_.exchange(next);
+        retired_.push_back({old, EpochDomain::instance().advance()});
+        reclaim_locked();
+    }
+
+    // Build from a pre-order sequence outside any lock, then publish
+    void rebuild(const std::vector<T>& preorder) {
+        publish(Solution<T>().sortedArrayToBSTIterative(preorder));
+    }
+
+    // Free retired versions no reader can still reach; returns how many
+    // are still waiting on readers
+    size_t reclaim() {
+        std::lock_guard lock(writer_);
+        return reclaim_locked();
+    }
+
+private:
+    struct Retired {
+        Version* version;
+        uint64_t safe_after; // freeable once every active reader announced at least this
+    };
+
+    size_t reclaim_locked() {
+        const uint64_t oldest = EpochDomain::instance().oldest_active();
+        auto done = std::stable_partition(retired_.begin(), retired_.end(),
+                                          [&](const Retired& r) { return r.safe_after > oldest; });
+        for (auto it = done; it != retired_.end(); ++it) delete it->version;
+        retired_.erase(done, retired_.end());
+        return retired_.size();
+    }
+
+    std::atomic<Version*> current_;
+    std::mutex writer_; // serializes publish and reclaim
+    std::vector<Retired> retired_;
 };
 
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 int main() {
     // Pre-order array: [10, 5, 1, 7, 15, 12, 20]
     // This represents a valid BST pre-order traversal
@@ -78,7 +1592,146 @@ int main() {
     std::cout << "BST Created (Pre-order): ";
     s.printTree(root);
     std::cout << std::endl;
+
+    // Same tree, nodes allocated from one contiguous arena block
+    NodeArena<int> arena;
+    auto arena_root = s.sortedArrayToBST(nums, arena);
+    std::cout << "BST Created from arena (Pre-order): ";
+    s.printTree(arena_root);
+    std::cout << "(" << arena.size() << " nodes)" << std::endl;
+
+    // Iterative build handles degenerate input that would overflow the recursive one
+    auto iter_root = s.sortedArrayToBSTIterative(nums);
+    std::cout << "BST Created iteratively (Pre-order): ";
+    s.printTree(iter_root);
+    std::cout << std::endl;
+
+    std::vector<int> descending(1'000'000);
+    for (size_t i = 0; i < descending.size(); ++i) {
+        descending[i] = static_cast<int>(descending.size() - i);
+    }
+    NodeArena<int> chain_arena;
+    auto chain = s.sortedArrayToBSTIterative(descending, chain_arena);
+    std::cout << "Degenerate 1M-key chain built iteratively: root " << chain->val
+              << ", " << chain_arena.size() << " nodes" << std::endl;
     
-    // root is automatically destroyed here. No leak.
+    // Same tree, pushed in chunks as if read from a stream
+    StreamingBSTBuilder<int> streaming;
+    for (size_t first = 0; first < nums.size(); first += 3) {
+        streaming.feed(std::span<const int>(nums).subspan(first, std::min<size_t>(3, nums.size() - first)));
+    }
+    auto streamed_root = streaming.finish();
+    std::cout << "BST Created from a stream (Pre-order): ";
+    s.printTree(streamed_root);
+    std::cout << std::endl;
+    try {
+        const std::vector<int> bad = {10, 5, 12, 7}; // 7 arrives after the right subtree of 10 started
+        streaming.feed(bad);
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Rejected early: " << e.what() << std::endl;
+    }
+
+    // Lazy traversals: stop early and feed range adaptors, no vector built
+    std::cout << "First three keys in order:";
+    for (int val : inorder(root.get()) | std::views::take(3)) {
+        std::cout << " " << val;
+    }
+    std::cout << std::endl;
+    std::cout << "Even keys in [6, 15]:";
+    for (int val : inorderRange(root.get(), 6, 15) | std::views::filter([](int v) { return v % 2 == 0; })) {
+        std::cout << " " << val;
+    }
+    std::cout << std::endl;
+
+    // Frozen Eytzinger copy for read-mostly lookups
+    EytzingerTree<int> frozen(root);
+    std::cout << "Eytzinger lookups: contains(7)=" << frozen.contains(7)
+              << ", contains(8)=" << frozen.contains(8) << std::endl;
+    std::vector<int> probes = {1, 2, 5, 10, 11, 12, 20, 21};
+    bool hits[8];
+    frozen.contains_many(probes, hits);
+    std::cout << "Batched lookups:";
+    for (size_t i = 0; i < probes.size(); ++i) {
+        std::cout << " " << probes[i] << (hits[i] ? "+" : "-");
+    }
+    std::cout << std::endl;
+
+    // Compile-time table lookups
+    for (int opcode : {0x01, 0xE8, 0x42}) {
+        const std::string_view* name = opcode_names.find(opcode);
+        std::cout << "opcode 0x" << std::hex << opcode << std::dec << ": "
+                  << (name ? *name : std::string_view("unknown")) << std::endl;
+    }
+
+    // Truly sorted input: balanced, one contiguous block, built in parallel
+    std::vector<int> sorted_keys(1 << 20);
+    for (size_t i = 0; i < sorted_keys.size(); ++i) {
+        sorted_keys[i] = static_cast<int>(2 * i);
+    }
+    NodeArena<int> balanced_arena;
+    auto balanced_root = s.sortedArrayToBalancedBST(sorted_keys, balanced_arena);
+    std::cout << "Balanced build from 1M sorted keys: root " << balanced_root->val << ", "
+              << balanced_arena.size() << " nodes" << std::endl;
+
+    // Out-of-order keys past the parallel cutoff are rejected from the
+    // forked build without touching the arena
+    std::vector<int> unsorted_keys(sorted_keys.begin(), sorted_keys.begin() + (1 << 16));
+    std::swap(unsorted_keys[100], unsorted_keys[101]);
+    try {
+        s.sortedArrayToBalancedBST(unsorted_keys, balanced_arena, 4);
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Rejected unsorted input: " << e.what() << ", arena still " << balanced_arena.size()
+                  << " nodes" << std::endl;
+    }
+
+    // Same keys on 2M pages, interleaved across NUMA nodes: one arena block
+    // and one flattened copy, each its own huge-page mapping
+    const HugePageOptions huge{HugePages::transparent, NumaPlacement::interleave};
+    using HugeNodes = HugePageAllocator<ArenaTreeNode<int>>;
+    NodeArena<int, HugeNodes> huge_arena(sorted_keys.size(), HugeNodes(huge));
+    auto huge_root = s.sortedArrayToBalancedBST(sorted_keys, huge_arena);
+    EytzingerTree<int, HugePageAllocator<int>> huge_frozen(huge_root, HugePageAllocator<int>(huge));
+    std::cout << "Huge-page arena: root " << huge_root->val << ", contains(2048)=" << huge_frozen.contains(2048)
+              << ", contains(2049)=" << huge_frozen.contains(2049) << std::endl;
+
+    // Incremental updates: ascending inserts stay balanced
+    BalancedBST<int> balanced;
+    for (int key = 1; key <= 1000; ++key) {
+        balanced.insert(key);
+    }
+    for (int key = 2; key <= 1000; key += 2) {
+        balanced.erase(key);
+    }
+    std::cout << "Balanced BST: " << balanced.size() << " keys, height " << balanced.height()
+              << ", contains(501)=" << balanced.contains(501) << ", contains(500)=" << balanced.contains(500)
+              << std::endl;
+
+    // Readers keep their snapshot while a writer swaps in a rebuilt tree
+    ConcurrentBST<int> shared(s.sortedArrayToBSTIterative(nums));
+    {
+        auto before = shared.snapshot();
+        std::jthread writer([&] { shared.rebuild({40, 30, 50}); });
+        writer.join();
+        auto after = shared.snapshot();
+        std::cout << "Concurrent BST: v" << before.version() << " contains(10)=" << before.contains(10)
+                  << ", v" << after.version() << " contains(10)=" << after.contains(10)
+                  << " contains(40)=" << after.contains(40) << std::endl;
+    }
+    std::cout << "Versions awaiting reclamation: " << shared.reclaim() << std::endl;
+
+    // Snapshot to disk, then query the mapped file in place
+    const std::string snapshot_path = (std::filesystem::temp_directory_path() / "build_bst.snapshot").string();
+    writeSnapshot(root.get(), snapshot_path);
+    {
+        SnapshotView<int> snapshot(snapshot_path);
+        std::cout << "Snapshot: " << snapshot.size() << " nodes, contains(12)=" << snapshot.contains(12)
+                  << ", contains(13)=" << snapshot.contains(13) << ", checksum "
+                  << (snapshot.verify_checksum() ? "ok" : "bad") << ", "
+                  << (snapshot.validate() ? "valid" : "invalid") << " BST" << std::endl;
+    }
+    std::filesystem::remove(snapshot_path);
+
+    // root and arena are automatically destroyed here. No leak.
     return 0;
-}
\ No newline at end of file
+}
+#endif // CODESTUDIO_NO_MAIN
@@ -5,6 +5,14 @@
 #include <tuple>
 #include <vector>
 #include <functional>
+#include <execution>
+#include <thread>
+#include <type_traits>
+#include <algorithm>
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define HAS_EXPERIMENTAL_SIMD 1
+#endif
 
 // ============================================================================
 // C++17 FEATURES SHOWCASE - IMPROVED VERSION
@@ -124,6 +132,211 @@ void fold_expressions_example() {
     std::cout << "All positive(1,-2,3): " << (all_positive(1, -2, 3) ? "true" : "false") << "\n";
 }
 
+// 4b. FOLD REDUCERS OVER LARGE BUFFERS
+// ============================================================================
+// Same sum_all / multiply_all / all_positive names, applied to a buffer
+// instead of a parameter pack. C++17 has no std::span, so ArrayView is a
+// minimal read-only view; CTAD deduces T from a vector or a pointer + size.
+template<typename T>
+struct ArrayView {
+    const T* data;
+    size_t size;
+
+    ArrayView(const T* d, size_t n) : data(d), size(n) {}
+
+    template<typename Alloc>
+    ArrayView(const std::vector<T, Alloc>& v) : data(v.data()), size(v.size()) {}
+};
+
+namespace reduce_detail {
+
+// Four independent accumulators hide the latency of the add/multiply chain.
+// Arithmetic types go through std::experimental::simd (when available), so
+// each accumulator holds a full vector register; the rest use scalars.
+template<typename T, typename Op>
+T fold_range(const T* data, size_t n, T identity, Op op) {
+    size_t i = 0;
+    T result = identity;
+
+    if constexpr (std::is_arithmetic_v<T>) {
+#ifdef HAS_EXPERIMENTAL_SIMD
+        namespace stdx = std::experimental;
+        using V = stdx::native_simd<T>;
+        constexpr size_t lanes = V::size();
+        V acc0(identity), acc1(identity), acc2(identity), acc3(identity);
+        for (; i + 4 * lanes <= n; i += 4 * lanes) {
+            acc0 = op(acc0, V(data + i, stdx::element_aligned));
+            acc1 = op(acc1, V(data + i + lanes, stdx::element_aligned));
+            acc2 = op(acc2, V(data + i + 2 * lanes, stdx::element_aligned));
+            acc3 = op(acc3, V(data + i + 3 * lanes, stdx::element_aligned));
+        }
+        result = stdx::reduce(op(op(acc0, acc1), op(acc2, acc3)), op);
+#endif
+    }
+
+    T acc[4] = {identity, identity, identity, identity};
+    for (; i + 4 <= n; i += 4) {
+        acc[0] = op(acc[0], data[i]);
+        acc[1] = op(acc[1], data[i + 1]);
+        acc[2] = op(acc[2], data[i + 2]);
+        acc[3] = op(acc[3], data[i + 3]);
+    }
+    for (; i < n; ++i) {
+        acc[0] = op(acc[0], data[i]);
+    }
+    return op(result, op(op(acc[0], acc[1]), op(acc[2], acc[3])));
+}
+
+// Checked block by block so a non-positive value stops the scan early
+template<typename T>
+bool all_positive_range(const T* data, size_t n) {
+    constexpr size_t block = 4096;
+    for (size_t first = 0; first < n; first += block) {
+        size_t count = std::min(block, n - first);
+        const T* p = data + first;
+        bool ok = true;
+        if constexpr (std::is_arithmetic_v<T>) {
+            // Branch-free inside the block so it vectorizes
+            for (size_t i = 0; i < count; ++i) {
+                ok &= p[i] > T(0);
+            }
+        } else {
+            ok = std::all_of(p, p + count, [](const T& v) { return v > T(0); });
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// One result slot per worker, on its own cache line. A plain
+// std::vector<R> would be std::vector<bool> for all_positive, whose
+// elements share words, so concurrent writes would race.
+template<typename R>
+struct alignas(64) PartialResult {
+    R value;
+};
+
+// Run `reduce_part` on one chunk per thread and combine the partial
+// results; small inputs stay on the calling thread. max_threads = 0 means
+// one per hardware thread.
+template<typename R, typename Part, typename Combine>
+R parallel_reduce(size_t n, R identity, Part reduce_part, Combine combine, size_t max_threads = 0) {
+    constexpr size_t min_chunk = 1 << 16;
+    size_t threads = max_threads != 0 ? max_threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<size_t>(1, n / min_chunk));
+    if (threads == 1) {
+        return reduce_part(0, n);
+    }
+
+    std::vector<PartialResult<R>> partial(threads, PartialResult<R>{identity});
+    {
+        std::vector<std::thread> workers;
+        size_t chunk = (n + threads - 1) / threads;
+        for (size_t t = 1; t < threads; ++t) {
+            size_t first = std::min(n, t * chunk);
+            size_t last = std::min(n, first + chunk);
+            workers.emplace_back([&partial, &reduce_part, t, first, last] {
+                partial[t].value = reduce_part(first, last);
+            });
+        }
+        partial[0].value = reduce_part(0, std::min(n, chunk));
+        for (auto& w : workers) w.join();
+    }
+
+    R result = identity;
+    for (const auto& p : partial) {
+        result = combine(result, p.value);
+    }
+    return result;
+}
+
+template<typename Policy>
+constexpr bool is_parallel_v = std::is_execution_policy_v<std::decay_t<Policy>> &&
+                               !std::is_same_v<std::decay_t<Policy>, std::execution::sequenced_policy>;
+
+} // namespace reduce_detail
+
+template<typename T>
+T sum_all(ArrayView<T> values) {
+    return reduce_detail::fold_range(values.data, values.size, T(0), std::plus<>{});
+}
+
+template<typename T>
+T multiply_all(ArrayView<T> values) {
+    return reduce_detail::fold_range(values.data, values.size, T(1), std::multiplies<>{});
+}
+
+template<typename T>
+bool all_positive(ArrayView<T> values) {
+    return reduce_detail::all_positive_range(values.data, values.size);
+}
+
+// Execution-policy overloads: std::execution::seq runs inline, any other
+// policy splits the buffer across threads. Floating-point sums are
+// reassociated, so the last bits may differ from a left-to-right fold.
+template<typename Policy, typename T,
+         std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, int> = 0>
+T sum_all(Policy&&, ArrayView<T> values) {
+    if constexpr (!reduce_detail::is_parallel_v<Policy>) {
+        return sum_all(values);
+    } else {
+        return reduce_detail::parallel_reduce(values.size, T(0),
+            [&](size_t first, size_t last) { return sum_all(ArrayView<T>(values.data + first, last - first)); },
+            std::plus<>{});
+    }
+}
+
+template<typename Policy, typename T,
+         std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, int> = 0>
+T multiply_all(Policy&&, ArrayView<T> values) {
+    if constexpr (!reduce_detail::is_parallel_v<Policy>) {
+        return multiply_all(values);
+    } else {
+        return reduce_detail::parallel_reduce(values.size, T(1),
+            [&](size_t first, size_t last) { return multiply_all(ArrayView<T>(values.data + first, last - first)); },
+            std::multiplies<>{});
+    }
+}
+
+template<typename Policy, typename T,
+         std::enable_if_t<std::is_execution_policy_v<std::decay_t<Policy>>, int> = 0>
+bool all_positive(Policy&&, ArrayView<T> values) {
+    if constexpr (!reduce_detail::is_parallel_v<Policy>) {
+        return all_positive(values);
+    } else {
+        return reduce_detail::parallel_reduce(values.size, true,
+            [&](size_t first, size_t last) { return all_positive(ArrayView<T>(values.data + first, last - first)); },
+            std::logical_and<>{});
+    }
+}
+
+void buffer_reducers_example() {
+    std::cout << "\n=== 4b. Fold Reducers over Buffers ===\n";
+
+    std::vector<int> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i + 1);
+    }
+    std::cout << "Sum(1..1000): " << sum_all(ArrayView(values)) << "\n";
+    std::cout << "Sum(1..1000), parallel: " << sum_all(std::execution::par, ArrayView(values)) << "\n";
+
+    std::vector<double> factors = {1.5, 2.0, 4.0};
+    std::cout << "Product(1.5,2,4): " << multiply_all(ArrayView(factors)) << "\n";
+    std::cout << "All positive(1..1000): " << (all_positive(ArrayView(values)) ? "true" : "false") << "\n";
+    values[500] = -1;
+    std::cout << "All positive after values[500] = -1: " << (all_positive(ArrayView(values)) ? "true" : "false") << "\n";
+
+    // Parallel check with a single negative value in the last of 8 chunks
+    std::vector<int> large(1 << 20, 1);
+    large.back() = -1;
+    const ArrayView<int> view(large);
+    bool parallel_ok = reduce_detail::parallel_reduce(view.size, true,
+        [&](size_t first, size_t last) { return all_positive(ArrayView<int>(view.data + first, last - first)); },
+        std::logical_and<>{}, 8);
+    std::cout << "All positive(2^20 values, last = -1), 8 threads: " << (parallel_ok ? "true" : "false")
+              << ", par policy: " << (all_positive(std::execution::par, view) ? "true" : "false") << "\n";
+}
+
 // 5. STD::OPTIONAL
 // ============================================================================
 std::optional<int> divide(int a, int b) {
@@ -290,6 +503,8 @@ namespace config {
     inline double version = 1.0;
 }
 
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 // Main function
 int main() {
     std::cout << "=== C++17 FEATURES SHOWCASE ===\n";
@@ -302,6 +517,7 @@ int main() {
     constexpr_if_example();
     
     fold_expressions_example();
+    buffer_reducers_example();
     
     optional_example();
     variant_example();
@@ -320,3 +536,4 @@ int main() {
     
     return 0;
 }
+#endif // CODESTUDIO_NO_MAIN
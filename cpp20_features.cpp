@@ -9,6 +9,20 @@
 #include <source_location>
 #include <span>
 #include <array>
+#include <functional>
+#include <optional>
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <cstdint>
+#include <sstream>
+#include <string_view>
 
 // ============================================================================
 // C++20 FEATURES SHOWCASE
@@ -209,6 +223,300 @@ void jthread_example() {
     std::cout << "All threads finished\n";
 }
 
+// 7b. WORK-STEALING THREAD POOL
+// ============================================================================
+// A fixed set of std::jthread workers instead of one thread per task. Each
+// worker owns a deque: it pops its own newest task (cache-warm, LIFO) and,
+// when idle, steals the oldest task from another worker (FIFO). Tasks that
+// accept a std::stop_token as first argument can poll it and finish early:
+// submit(token, f, ...) hands them the caller's token, so one caller can
+// cancel its own batch without touching anybody else's work on a shared
+// pool. That token also fires when the pool is destroyed, which is the
+// only pool-wide stop.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency())
+        : queues_(std::max(threads, 1u)) {
+        workers_.reserve(queues_.size());
+        for (size_t i = 0; i < queues_.size(); ++i) {
+            workers_.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Queued tasks that never started are dropped (their futures report
+    // broken_promise); running tasks see the stop request
+    ~WorkStealingPool() {
+        stop_.request_stop();
+        workers_.clear(); // join before the queues go away
+    }
+
+    size_t size() const { return queues_.size(); }
+
+    // Cancellable tasks only see the pool shutting down
+    template<typename F, typename... Args>
+    requires(!std::is_same_v<std::remove_cvref_t<F>, std::stop_token>)
+    auto submit(F&& f, Args&&... args) {
+        return submit(std::stop_token{}, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    // Cancellable tasks get a token that fires when `stop` does or when the
+    // pool shuts down. A task whose token fired before it started still
+    // runs, so its future gets a value; it just sees the stop right away.
+    template<typename F, typename... Args>
+    auto submit(std::stop_token stop, F&& f, Args&&... args) {
+        auto bound = [this, stop = std::move(stop), f = std::forward<F>(f),
+                      ...args = std::forward<Args>(args)]() mutable {
+            if constexpr (std::is_invocable_v<F&, std::stop_token, Args&...>) {
+                std::stop_source merged;
+                auto forward_stop = [&merged] { merged.request_stop(); };
+                std::stop_callback on_caller(stop, forward_stop);
+                std::stop_callback on_shutdown(stop_.get_token(), forward_stop);
+                return std::invoke(f, merged.get_token(), args...);
+            } else {
+                return std::invoke(f, args...);
+            }
+        };
+        using R = std::invoke_result_t<decltype(bound)&>;
+        std::packaged_task<R()> task(std::move(bound));
+        std::future<R> result = task.get_future();
+        push(std::make_unique<TaskImpl<std::packaged_task<R()>>>(std::move(task)));
+        return result;
+    }
+
+    // Block on a future without idling: run queued tasks until it is ready.
+    // Needed when a task waits on tasks it submitted itself.
+    template<typename R>
+    R wait(std::future<R>& future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (auto task = take(home_index())) {
+                task->run();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        return future.get();
+    }
+
+private:
+    struct Task {
+        virtual ~Task() = default;
+        virtual void run() = 0;
+    };
+
+    template<typename F>
+    struct TaskImpl : Task {
+        F fn;
+        explicit TaskImpl(F f) : fn(std::move(f)) {}
+        void run() override { fn(); }
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::unique_ptr<Task>> tasks;
+    };
+
+    // Which pool (if any) the current thread works for, and its queue
+    inline static thread_local const WorkStealingPool* current_pool_ = nullptr;
+    inline static thread_local size_t current_index_ = 0;
+
+    size_t home_index() const {
+        return current_pool_ == this ? current_index_ : 0;
+    }
+
+    void push(std::unique_ptr<Task> task) {
+        // Workers keep their own children local; outside threads spread out
+        size_t index = current_pool_ == this
+            ? current_index_
+            : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard lock(queues_[index].mutex);
+            queues_[index].tasks.push_back(std::move(task));
+        }
+        pending_.fetch_add(1, std::memory_order_release);
+        {
+            // Taking the lock orders this notify after a sleeper's predicate check
+            std::lock_guard lock(sleep_mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    std::unique_ptr<Task> take(size_t home) {
+        {
+            Queue& own = queues_[home];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                auto task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        for (size_t step = 1; step < queues_.size(); ++step) {
+            Queue& victim = queues_[(home + step) % queues_.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                auto task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void run(size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+        std::stop_token stop = stop_.get_token();
+        while (!stop.stop_requested()) {
+            if (auto task = take(index)) {
+                task->run();
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            // Wakes on new work or on the stop request
+            wake_.wait(lock, stop, [this] { return pending_.load(std::memory_order_acquire) > 0; });
+        }
+    }
+
+    std::vector<Queue> queues_;
+    std::stop_source stop_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable_any wake_;
+    std::vector<std::jthread> workers_; // last member: joined first
+};
+
+// Process-wide pool shared by the parallel helpers below
+WorkStealingPool& default_pool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+void thread_pool_example() {
+    std::cout << "\n=== 7b. Work-Stealing Thread Pool ===\n";
+
+    WorkStealingPool pool(4);
+
+    // submit() returns a future for the task's result
+    std::vector<std::future<int>> squares;
+    for (int i = 1; i <= 5; ++i) {
+        squares.push_back(pool.submit([](int x) { return x * x; }, i));
+    }
+    std::cout << "Squares from pool:";
+    for (auto& f : squares) {
+        std::cout << " " << f.get();
+    }
+    std::cout << "\n";
+
+    // Recursive tasks: a task waits on subtasks it spawned, helping meanwhile
+    std::function<long(long, long)> range_sum = [&](long first, long last) -> long {
+        if (last - first <= 1000) {
+            long sum = 0;
+            for (long i = first; i < last; ++i) sum += i;
+            return sum;
+        }
+        long mid = first + (last - first) / 2;
+        auto left = pool.submit(range_sum, first, mid);
+        long right = range_sum(mid, last);
+        return pool.wait(left) + right;
+    };
+    auto total = pool.submit(range_sum, 0L, 1'000'000L);
+    std::cout << "Sum 0..999999 via recursive tasks: " << pool.wait(total) << "\n";
+
+    // Cooperative cancellation: stopping this caller's source ends its task
+    // and leaves the pool running
+    std::stop_source cancel;
+    auto spinner = pool.submit(cancel.get_token(), [](std::stop_token stop) {
+        int spins = 0;
+        while (!stop.stop_requested()) {
+            ++spins;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return spins > 0;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    cancel.request_stop();
+    std::cout << "Cancellable task stopped cooperatively: " << (spinner.get() ? "yes" : "no") << "\n";
+    auto after = pool.submit([] { return 42; });
+    std::cout << "Pool still accepts work after the cancel: " << after.get() << "\n";
+}
+
+// Parallel, fused execution of a view pipeline
+// ----------------------------------------------------------------------------
+// `pipeline` is a range adaptor closure such as
+//     std::views::filter(pred) | std::views::transform(f)
+// The source is split into one contiguous chunk per thread, the closure is
+// applied to each chunk and the resulting lazy view is folded directly, so
+// filter + transform + reduce is a single pass with no intermediate storage.
+// op must be associative; init is combined with the chunk results once.
+// Chunks run as pool tasks; there are a few per worker so that stealing can
+// even out chunks whose filter keeps more elements than others.
+template<std::ranges::random_access_range R, typename Pipeline, typename T, typename Op = std::plus<>>
+requires std::ranges::sized_range<R>
+T reduce_pipeline(R&& source, Pipeline pipeline, T init, Op op = {},
+                  WorkStealingPool& pool = default_pool()) {
+    const size_t n = std::ranges::size(source);
+    constexpr size_t min_chunk = 1 << 14;
+    const size_t chunks = std::clamp<size_t>(n / min_chunk, 1, pool.size() * 4);
+
+    // A chunk may filter down to nothing, so partial results are optional
+    // and no identity element is needed
+    auto fold_chunk = [&](size_t first, size_t last) -> std::optional<T> {
+        auto begin = std::ranges::begin(source);
+        auto view = std::ranges::subrange(begin + first, begin + last) | pipeline;
+        auto it = std::ranges::begin(view);
+        auto end = std::ranges::end(view);
+        if (it == end) return std::nullopt;
+        T acc = *it;
+        for (++it; it != end; ++it) {
+            acc = op(std::move(acc), *it);
+        }
+        return acc;
+    };
+
+    const size_t chunk_size = (n + chunks - 1) / chunks;
+    std::vector<std::future<std::optional<T>>> partial;
+    for (size_t c = 1; c < chunks; ++c) {
+        size_t first = std::min(n, c * chunk_size);
+        size_t last = std::min(n, first + chunk_size);
+        partial.push_back(pool.submit(fold_chunk, first, last));
+    }
+    // The calling thread takes the first chunk, then helps with the rest
+    std::optional<T> head = fold_chunk(0, std::min(n, chunk_size));
+    if (head) init = op(std::move(init), std::move(*head));
+
+    for (auto& f : partial) {
+        std::optional<T> p = pool.wait(f);
+        if (p) init = op(std::move(init), std::move(*p));
+    }
+    return init;
+}
+
+void parallel_pipeline_example() {
+    std::cout << "\n=== 7c. Parallel Fused Pipeline ===\n";
+
+    std::vector<long> nums(1'000'000);
+    for (size_t i = 0; i < nums.size(); ++i) {
+        nums[i] = static_cast<long>(i + 1);
+    }
+
+    // Same filter | transform chain as in ranges_example, as a reusable closure
+    auto even_squares = std::views::filter([](long n) { return n % 2 == 0; })
+                      | std::views::transform([](long n) { return n * n % 1000; });
+
+    long total = reduce_pipeline(nums, even_squares, 0L);
+    std::cout << "Sum of (even n)^2 % 1000 over 1..1000000: " << total << "\n";
+
+    long biggest = reduce_pipeline(nums, std::views::transform([](long n) { return n % 9973; }), 0L,
+                                   [](long a, long b) { return std::max(a, b); });
+    std::cout << "Max of n % 9973: " << biggest << "\n";
+}
+
 // 8. CONSTEXPR IMPROVEMENTS
 // ============================================================================
 // constexpr std::string (C++20)
@@ -249,6 +557,250 @@ void source_location_example() {
     log_message("This is a log message");
 }
 
+// 9b. TRACEPOINTS - source_location without the iostream cost
+// ============================================================================
+// log_message formats on every call. A tracepoint instead captures its
+// source_location once, in a static constexpr object per call site, and the
+// hot path only appends {tracepoint*, timestamp, value} to a per-thread
+// ring buffer: no locks, no allocation, no formatting. The buffers are
+// dumped offline as Chrome trace JSON (chrome://tracing, Perfetto).
+// Build with -DCODESTUDIO_TRACING=0 and the macros expand to nothing.
+#ifndef CODESTUDIO_TRACING
+#define CODESTUDIO_TRACING 1
+#endif
+
+namespace tracing {
+
+struct Tracepoint {
+    const char* name;
+    std::source_location location;
+};
+
+enum class EventKind : std::uint8_t { begin, end, counter };
+
+struct TraceEvent {
+    const Tracepoint* point;
+    std::uint64_t timestamp_ns;
+    std::int64_t value;
+    EventKind kind;
+};
+
+// Single-writer flight recorder: the owning thread overwrites the oldest
+// events once it wraps. Readers must not run concurrently with the writer,
+// so dump after the traced threads have finished (or been joined).
+class TraceRing {
+public:
+    static constexpr size_t capacity = 4096; // power of two
+
+    explicit TraceRing(unsigned thread_id) : thread_id_(thread_id) {}
+
+    void record(const Tracepoint& point, EventKind kind, std::int64_t value = 0) {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        events_[head & (capacity - 1)] = {&point, now_ns(), value, kind};
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    unsigned thread_id() const { return thread_id_; }
+
+    // Surviving events, oldest first
+    template<typename Visit>
+    void for_each(Visit visit) const {
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        const std::uint64_t first = head > capacity ? head - capacity : 0;
+        for (std::uint64_t i = first; i < head; ++i) {
+            visit(events_[i & (capacity - 1)]);
+        }
+    }
+
+private:
+    static std::uint64_t now_ns() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    std::array<TraceEvent, capacity> events_;
+    std::atomic<std::uint64_t> head_{0};
+    unsigned thread_id_;
+};
+
+// Owns every thread's ring so the events outlive the threads that wrote
+// them. A ring goes back on a free list when its thread exits and the next
+// new thread appends to it, so memory is bounded by the peak number of live
+// traced threads rather than by how many were ever started. Its id is the
+// "tid" lane in the trace; threads that reuse a ring share its lane, one
+// after the other. The mutex is only taken when a thread starts or exits
+// and when dumping.
+class TraceRegistry {
+public:
+    static TraceRegistry& instance() {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    TraceRing& local_ring() {
+        thread_local RingLease lease{attach()};
+        return *lease.ring;
+    }
+
+    template<typename Visit>
+    void for_each_ring(Visit visit) {
+        std::lock_guard lock(mutex_);
+        for (const auto& ring : rings_) {
+            visit(*ring);
+        }
+    }
+
+private:
+    // Returns the ring to the registry when its thread exits
+    struct RingLease {
+        TraceRing* ring;
+        ~RingLease() { TraceRegistry::instance().detach(ring); }
+    };
+
+    TraceRing* attach() {
+        std::lock_guard lock(mutex_);
+        if (!free_.empty()) {
+            TraceRing* ring = free_.back();
+            free_.pop_back();
+            return ring;
+        }
+        rings_.push_back(std::make_unique<TraceRing>(static_cast<unsigned>(rings_.size())));
+        return rings_.back().get();
+    }
+
+    void detach(TraceRing* ring) {
+        std::lock_guard lock(mutex_);
+        free_.push_back(ring);
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<TraceRing>> rings_;
+    std::vector<TraceRing*> free_;
+};
+
+// RAII begin/end pair for a traced scope
+class TraceScope {
+public:
+    explicit TraceScope(const Tracepoint& point) : point_(point) {
+        TraceRegistry::instance().local_ring().record(point_, EventKind::begin);
+    }
+    ~TraceScope() { TraceRegistry::instance().local_ring().record(point_, EventKind::end); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const Tracepoint& point_;
+};
+
+inline void trace_counter(const Tracepoint& point, std::int64_t value) {
+    TraceRegistry::instance().local_ring().record(point, EventKind::counter, value);
+}
+
+// Quotes and backslashes are escaped; control characters become \u00XX
+inline void write_json_string(std::ostream& out, std::string_view text) {
+    constexpr char hex[] = "0123456789abcdef";
+    out << '"';
+    for (char c : text) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (byte < 0x20) {
+            out << "\\u00" << hex[byte >> 4] << hex[byte & 0xf];
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Chrome trace event format: B/E duration pairs and C counters, timestamps
+// in microseconds relative to the earliest surviving event
+inline size_t write_chrome_trace(std::ostream& out) {
+    auto& registry = TraceRegistry::instance();
+    std::uint64_t origin = UINT64_MAX;
+    registry.for_each_ring([&](const TraceRing& ring) {
+        ring.for_each([&](const TraceEvent& e) { origin = std::min(origin, e.timestamp_ns); });
+    });
+
+    size_t written = 0;
+    out << "{\"traceEvents\":[";
+    registry.for_each_ring([&](const TraceRing& ring) {
+        ring.for_each([&](const TraceEvent& e) {
+            constexpr const char* phases[] = {"B", "E", "C"};
+            out << (written++ ? ",\n" : "\n") << "{\"name\":";
+            write_json_string(out, e.point->name);
+            out << ",\"ph\":\"" << phases[static_cast<int>(e.kind)] << "\",\"ts\":"
+                << static_cast<double>(e.timestamp_ns - origin) / 1000.0
+                << ",\"pid\":1,\"tid\":" << ring.thread_id() << ",\"args\":{";
+            if (e.kind == EventKind::counter) {
+                out << "\"value\":" << e.value;
+            } else {
+                out << "\"file\":";
+                write_json_string(out, e.point->location.file_name());
+                out << ",\"line\":" << e.point->location.line() << ",\"function\":";
+                write_json_string(out, e.point->location.function_name());
+            }
+            out << "}}";
+        });
+    });
+    out << "\n]}\n";
+    return written;
+}
+
+} // namespace tracing
+
+#define CODESTUDIO_TRACE_CONCAT_IMPL(a, b) a##b
+#define CODESTUDIO_TRACE_CONCAT(a, b) CODESTUDIO_TRACE_CONCAT_IMPL(a, b)
+
+#if CODESTUDIO_TRACING
+// Trace the rest of the enclosing scope as one duration event
+#define CODESTUDIO_TRACE_SCOPE(name)                                                              \
+    static constexpr ::tracing::Tracepoint CODESTUDIO_TRACE_CONCAT(trace_point_, __LINE__){      \
+        name, std::source_location::current()};                                                   \
+    ::tracing::TraceScope CODESTUDIO_TRACE_CONCAT(trace_scope_, __LINE__)(                        \
+        CODESTUDIO_TRACE_CONCAT(trace_point_, __LINE__))
+// Record a sample of an integer counter
+#define CODESTUDIO_TRACE_COUNTER(name, value)                                                     \
+    do {                                                                                          \
+        static constexpr ::tracing::Tracepoint trace_point{name, std::source_location::current()}; \
+        ::tracing::trace_counter(trace_point, (value));                                           \
+    } while (0)
+#else
+#define CODESTUDIO_TRACE_SCOPE(name) static_assert(true)
+#define CODESTUDIO_TRACE_COUNTER(name, value) do {} while (0)
+#endif
+
+int traced_work(int n) {
+    CODESTUDIO_TRACE_SCOPE("traced_work");
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += i % 7;
+    }
+    CODESTUDIO_TRACE_COUNTER("traced_work.sum", sum);
+    return sum;
+}
+
+void tracing_example() {
+    std::cout << "\n=== 9b. Tracepoints ===\n";
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 3; ++t) {
+            threads.emplace_back([t] {
+                for (int i = 0; i < 4; ++i) {
+                    traced_work(1000 * (t + 1));
+                }
+            });
+        }
+    } // joined: the rings are quiescent before the dump
+
+    std::ostringstream trace;
+    size_t events = tracing::write_chrome_trace(trace);
+    std::cout << "Recorded " << events << " trace events ("
+              << (CODESTUDIO_TRACING ? "tracing on" : "tracing off") << "), "
+              << trace.str().size() << " bytes of Chrome trace JSON\n";
+}
+
 // 10. AGGREGATE INITIALIZATION WITH PRIVATE MEMBERS
 // ============================================================================
 struct Aggregate {
@@ -287,6 +839,8 @@ void contains_example() {
     }
 }
 
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 // Main function
 int main() {
     std::cout << "=== C++20 FEATURES SHOWCASE ===";
@@ -298,8 +852,11 @@ int main() {
     ranges_example();
     span_example();
     jthread_example();
+    thread_pool_example();
+    parallel_pipeline_example();
     constexpr_improvements_example();
     source_location_example();
+    tracing_example();
     aggregate_example();
     char8t_example();
     contains_example();
@@ -308,3 +865,4 @@ int main() {
     
     return 0;
 }
+#endif // CODESTUDIO_NO_MAIN
@@ -5,6 +5,14 @@
 #include <optional>
 #include <ranges>
 #include <memory>
+#include <span>
+#include <new>
+#include <stdexcept>
+#include <algorithm>
+#include <version>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
 
 // ============================================================================
 // C++23 FEATURES SHOWCASE
@@ -101,33 +109,165 @@ void explicit_this_example() {
 
 // 5. SUBSCRIPT OPERATOR[] AS MULTI-DIMENSIONAL INDEX
 // ============================================================================
+// Over-aligned allocator so the matrix buffer starts on a cache line
+template<typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, size_t n) {
+        ::operator delete(p, n * sizeof(T), std::align_val_t{Alignment});
+    }
+
+    friend bool operator==(const AlignedAllocator&, const AlignedAllocator&) { return true; }
+};
+
+// Non-owning 2D view of a matrix buffer
+#if defined(__cpp_lib_mdspan)
+template<typename T>
+using MatrixView = std::mdspan<T, std::dextents<size_t, 2>>;
+#else
+// Minimal row-major stand-in until the standard library ships <mdspan>
+template<typename T>
+class MatrixView {
+private:
+    T* ptr;
+    size_t rows, cols;
+
+public:
+    MatrixView(T* p, size_t r, size_t c) : ptr(p), rows(r), cols(c) {}
+
+    size_t extent(size_t dim) const { return dim == 0 ? rows : cols; }
+    size_t size() const { return rows * cols; }
+    T* data_handle() const { return ptr; }
+
+    T& operator[](size_t row, size_t col) const { return ptr[row * cols + col]; }
+};
+#endif
+
+template<typename T = int>
 class Matrix {
 private:
-    std::vector<std::vector<int>> data;
+    size_t rows_;
+    size_t cols_;
+    // One contiguous row-major buffer instead of a vector per row
+    std::vector<T, AlignedAllocator<T>> data;
     
 public:
-    Matrix(int rows, int cols) : data(rows, std::vector<int>(cols, 0)) {}
+    Matrix(size_t rows, size_t cols) : rows_(rows), cols_(cols), data(rows * cols, T{}) {}
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+
+    // C++23: true multidimensional subscript, m[i, j]
+    T& operator[](size_t row, size_t col) {
+        return data[row * cols_ + col];
+    }
+
+    const T& operator[](size_t row, size_t col) const {
+        return data[row * cols_ + col];
+    }
     
-    // Use traditional approach for compatibility
-    std::vector<int>& operator[](int row) {
-        return data[row];
+    // Row access keeps m[i][j] working for existing code
+    std::span<T> operator[](size_t row) {
+        return {data.data() + row * cols_, cols_};
     }
     
-    const std::vector<int>& operator[](int row) const {
-        return data[row];
+    std::span<const T> operator[](size_t row) const {
+        return {data.data() + row * cols_, cols_};
     }
+
+    MatrixView<T> view() { return MatrixView<T>(data.data(), rows_, cols_); }
+    MatrixView<const T> view() const { return MatrixView<const T>(data.data(), rows_, cols_); }
 };
 
+// Cache-blocked kernels: work on kTile x kTile blocks so both the source and
+// destination tiles stay in L1 instead of striding through whole rows
+constexpr size_t kTile = 32;
+
+template<typename T>
+Matrix<T> transpose(const Matrix<T>& m) {
+    Matrix<T> result(m.cols(), m.rows());
+    for (size_t ii = 0; ii < m.rows(); ii += kTile) {
+        for (size_t jj = 0; jj < m.cols(); jj += kTile) {
+            size_t i_end = std::min(ii + kTile, m.rows());
+            size_t j_end = std::min(jj + kTile, m.cols());
+            for (size_t i = ii; i < i_end; ++i) {
+                for (size_t j = jj; j < j_end; ++j) {
+                    result[j, i] = m[i, j];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> multiply(const Matrix<T>& a, const Matrix<T>& b) {
+    if (a.cols() != b.rows()) {
+        throw std::invalid_argument("Matrix dimensions do not match");
+    }
+
+    Matrix<T> result(a.rows(), b.cols());
+    const size_t n = a.rows(), inner = a.cols(), m = b.cols();
+    for (size_t ii = 0; ii < n; ii += kTile) {
+        for (size_t kk = 0; kk < inner; kk += kTile) {
+            for (size_t jj = 0; jj < m; jj += kTile) {
+                size_t i_end = std::min(ii + kTile, n);
+                size_t k_end = std::min(kk + kTile, inner);
+                size_t j_end = std::min(jj + kTile, m);
+                // i-k-j order: the innermost loop streams contiguous rows of
+                // b and result, which the compiler vectorizes
+                for (size_t i = ii; i < i_end; ++i) {
+                    T* __restrict out = &result[i, 0];
+                    for (size_t k = kk; k < k_end; ++k) {
+                        const T scale = a[i, k];
+                        const T* __restrict row = &b[k, 0];
+                        for (size_t j = jj; j < j_end; ++j) {
+                            out[j] += scale * row[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
 void multidimensional_subscript_example() {
     std::cout << "\n=== 5. Multidimensional Subscript Operator ===\n";
     
     Matrix m(3, 3);
-    m[0][0] = 1;
-    m[0][1] = 2;
-    m[1][1] = 5;
+    m[0, 0] = 1;
+    m[0, 1] = 2;
+    m[1][1] = 5;  // Row access still works
     
-    std::cout << "m[0][0] = " << m[0][0] << "\n";
-    std::cout << "m[1][1] = " << m[1][1] << "\n";
+    std::cout << "m[0, 0] = " << m[0, 0] << "\n";
+    std::cout << "m[1, 1] = " << m[1, 1] << "\n";
+
+    // Same storage seen through a 2D view
+    auto v = m.view();
+    std::cout << "view extents: " << v.extent(0) << "x" << v.extent(1)
+              << ", view[0, 1] = " << v[0, 1] << "\n";
+
+    // Tiled kernels
+    auto t = transpose(m);
+    std::cout << "transpose(m)[1, 0] = " << t[1, 0] << "\n";
+    auto p = multiply(m, t);
+    std::cout << "(m * m^T)[0, 0] = " << p[0, 0] << "\n";
 }
 
 // 6. AUTO SPECIFIER IN LAMBDA
@@ -151,7 +291,11 @@ void static_lambda_example() {
     std::cout << "\n=== 7. Static Lambdas ===\n";
     
     // Static lambdas - no capture allowed
+#if defined(__cpp_static_call_operator)
     auto pure_func = [](int x) static { return x * x; };
+#else
+    auto pure_func = [](int x) { return x * x; };  // Compiler predates static operator() (P1169)
+#endif
     
     std::cout << "pure_func(7) = " << pure_func(7) << "\n";
     
@@ -286,6 +430,8 @@ void explicit_object_forwarding_example() {
     ch.handle_const();
 }
 
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 // Main function
 int main() {
     std::cout << "=== C++23 FEATURES SHOWCASE ===";
@@ -310,3 +456,4 @@ int main() {
     
     return 0;
 }
+#endif // CODESTUDIO_NO_MAIN
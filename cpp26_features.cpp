@@ -6,6 +6,19 @@
 #include <memory>
 #include <variant>
 #include <cmath>
+#include <cassert>
+#include <utility>
+#include <string_view>
+#include <functional>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <bit>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <cstdlib>
 
 // ============================================================================
 // C++26 FEATURES SHOWCASE (Proposed/Future Features)
@@ -129,35 +142,319 @@ void reflection_example() {
 // ============================================================================
 // Proposed std::expected<T, E> for error handling without exceptions
 
+// Tags for in-place construction of the value or the error
+struct unexpect_t {
+    explicit unexpect_t() = default;
+};
+inline constexpr unexpect_t unexpect{};
+
+// Result type holding either a T or an E in place (no heap, no variant
+// index checks). Copy/move/destruction are trivial whenever they are for
+// both T and E, so e.g. Expected<int, ParseError> is passed in registers.
+// operator* and error() are unchecked; they assert in debug builds only.
 template<typename T, typename E>
 class Expected {
 private:
-    std::variant<T, E> value;
+    union {
+        T val;
+        E err;
+    };
+    bool has_val;
+
+    template<typename Other>
+    constexpr void construct_from(Other&& other) {
+        if (other.has_val) {
+            std::construct_at(std::addressof(val), std::forward<Other>(other).val);
+        } else {
+            std::construct_at(std::addressof(err), std::forward<Other>(other).err);
+        }
+        has_val = other.has_val;
+    }
+
+    constexpr void destroy() {
+        if (has_val) {
+            std::destroy_at(std::addressof(val));
+        } else {
+            std::destroy_at(std::addressof(err));
+        }
+    }
+
+    // Switch the storage from `current` to `next` built from args without
+    // ever leaving it empty, as std::expected does: a constructor that may
+    // throw runs into a temporary first, or the old alternative is moved
+    // aside and put back if it does throw
+    template<typename New, typename Old, typename... Args>
+    static constexpr void reinit(New& next, Old& current, Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<New, Args...>) {
+            std::destroy_at(std::addressof(current));
+            std::construct_at(std::addressof(next), std::forward<Args>(args)...);
+        } else if constexpr (std::is_nothrow_move_constructible_v<New>) {
+            New tmp(std::forward<Args>(args)...);
+            std::destroy_at(std::addressof(current));
+            std::construct_at(std::addressof(next), std::move(tmp));
+        } else {
+            Old saved(std::move(current));
+            std::destroy_at(std::addressof(current));
+            try {
+                std::construct_at(std::addressof(next), std::forward<Args>(args)...);
+            } catch (...) {
+                std::construct_at(std::addressof(current), std::move(saved));
+                throw;
+            }
+        }
+    }
+
+    // Same alternative: plain assignment; otherwise reinit
+    template<typename Other>
+    constexpr void assign_from(Other&& other) {
+        if (has_val && other.has_val) {
+            val = std::forward<Other>(other).val;
+        } else if (!has_val && !other.has_val) {
+            err = std::forward<Other>(other).err;
+        } else if (other.has_val) {
+            reinit(val, err, std::forward<Other>(other).val);
+            has_val = true;
+        } else {
+            reinit(err, val, std::forward<Other>(other).err);
+            has_val = false;
+        }
+    }
+
+    static constexpr bool trivially_copyable =
+        std::is_trivially_copy_constructible_v<T> && std::is_trivially_copy_constructible_v<E>;
+    static constexpr bool trivially_movable =
+        std::is_trivially_move_constructible_v<T> && std::is_trivially_move_constructible_v<E>;
+    static constexpr bool trivially_destructible =
+        std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+    static constexpr bool trivially_assignable =
+        trivially_copyable && trivially_destructible &&
+        std::is_trivially_copy_assignable_v<T> && std::is_trivially_copy_assignable_v<E>;
+    // What reinit needs to restore the old alternative if building the new
+    // one throws
+    static constexpr bool reinit_safe =
+        std::is_nothrow_move_constructible_v<T> || std::is_nothrow_move_constructible_v<E>;
     
 public:
-    Expected(const T& v) : value(v) {}
-    Expected(const E& e) : value(e) {}
-    
-    bool has_value() const {
-        return std::holds_alternative<T>(value);
+    using value_type = T;
+    using error_type = E;
+
+    constexpr Expected(const T& v) : val(v), has_val(true) {}
+    constexpr Expected(T&& v) : val(std::move(v)), has_val(true) {}
+    // When T and E are the same type, errors need the unexpect tag
+    constexpr Expected(const E& e) requires (!std::is_same_v<T, E>) : err(e), has_val(false) {}
+    constexpr Expected(E&& e) requires (!std::is_same_v<T, E>) : err(std::move(e)), has_val(false) {}
+
+    // Build the value or the error directly in the storage
+    template<typename... Args>
+    constexpr explicit Expected(std::in_place_t, Args&&... args)
+        : val(std::forward<Args>(args)...), has_val(true) {}
+
+    template<typename... Args>
+    constexpr explicit Expected(unexpect_t, Args&&... args)
+        : err(std::forward<Args>(args)...), has_val(false) {}
+
+    // C++20 conditionally trivial special members: the defaulted overload
+    // wins whenever its constraint holds
+    constexpr Expected(const Expected&) requires trivially_copyable = default;
+    constexpr Expected(const Expected& other) { construct_from(other); }
+
+    constexpr Expected(Expected&&) requires trivially_movable = default;
+    constexpr Expected(Expected&& other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                  std::is_nothrow_move_constructible_v<E>) {
+        construct_from(std::move(other));
+    }
+
+    constexpr Expected& operator=(const Expected&) requires trivially_assignable = default;
+    constexpr Expected& operator=(const Expected& other) requires (!trivially_assignable) && reinit_safe {
+        if (this != &other) {
+            assign_from(other);
+        }
+        return *this;
+    }
+
+    constexpr Expected& operator=(Expected&&) requires trivially_assignable = default;
+    constexpr Expected& operator=(Expected&& other) requires (!trivially_assignable) && reinit_safe {
+        if (this != &other) {
+            assign_from(std::move(other));
+        }
+        return *this;
+    }
+
+    constexpr ~Expected() requires trivially_destructible = default;
+    constexpr ~Expected() { destroy(); }
+
+    // Either the constructor cannot throw or T moves without throwing, so
+    // reinit never has to put back what it replaced
+    template<typename... Args>
+        requires std::is_nothrow_constructible_v<T, Args...> || std::is_nothrow_move_constructible_v<T>
+    constexpr T& emplace(Args&&... args) {
+        if (has_val) {
+            reinit(val, val, std::forward<Args>(args)...);
+        } else {
+            reinit(val, err, std::forward<Args>(args)...);
+        }
+        has_val = true;
+        return val;
     }
     
-    T& operator*() {
-        return std::get<T>(value);
+    constexpr bool has_value() const {
+        return has_val;
     }
+
+    constexpr explicit operator bool() const { return has_val; }
     
-    E& error() {
-        return std::get<E>(value);
+    constexpr T& operator*() & { assert(has_val); return val; }
+    constexpr const T& operator*() const& { assert(has_val); return val; }
+    constexpr T&& operator*() && { assert(has_val); return std::move(val); }
+
+    constexpr T* operator->() { assert(has_val); return std::addressof(val); }
+    constexpr const T* operator->() const { assert(has_val); return std::addressof(val); }
+    
+    constexpr E& error() & { assert(!has_val); return err; }
+    constexpr const E& error() const& { assert(!has_val); return err; }
+    constexpr E&& error() && { assert(!has_val); return std::move(err); }
+
+    template<typename U>
+    constexpr T value_or(U&& fallback) const& {
+        return has_val ? val : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    // Monadic chaining: f(value) -> Expected<U, E>; errors pass through untouched
+    template<typename F>
+    constexpr auto and_then(F&& f) const& {
+        using Result = std::remove_cvref_t<std::invoke_result_t<F, const T&>>;
+        if (has_val) return std::invoke(std::forward<F>(f), val);
+        return Result(unexpect, err);
+    }
+
+    template<typename F>
+    constexpr auto and_then(F&& f) && {
+        using Result = std::remove_cvref_t<std::invoke_result_t<F, T&&>>;
+        if (has_val) return std::invoke(std::forward<F>(f), std::move(val));
+        return Result(unexpect, std::move(err));
+    }
+
+    // f(value) -> U; wraps the result as Expected<U, E>
+    template<typename F>
+    constexpr auto transform(F&& f) const& {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, const T&>>;
+        if (has_val) return Expected<U, E>(std::in_place, std::invoke(std::forward<F>(f), val));
+        return Expected<U, E>(unexpect, err);
+    }
+
+    template<typename F>
+    constexpr auto transform(F&& f) && {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, T&&>>;
+        if (has_val) return Expected<U, E>(std::in_place, std::invoke(std::forward<F>(f), std::move(val)));
+        return Expected<U, E>(unexpect, std::move(err));
     }
 };
 
-Expected<int, std::string> parse_number(const std::string& str) {
-    try {
-        int num = std::stoi(str);
-        return Expected<int, std::string>(num);
-    } catch (...) {
-        return Expected<int, std::string>(std::string("Invalid number"));
+// Error codes instead of heap-allocated messages
+enum class ParseError {
+    invalid_number,
+    out_of_range,
+};
+
+constexpr std::string_view describe(ParseError e) {
+    switch (e) {
+        case ParseError::invalid_number: return "Invalid number";
+        case ParseError::out_of_range: return "Number out of range";
     }
+    return "Unknown error";
+}
+
+std::ostream& operator<<(std::ostream& os, ParseError e) {
+    return os << describe(e);
+}
+
+static_assert(std::is_trivially_copyable_v<Expected<int, ParseError>>,
+              "Expected of trivial types must stay trivially copyable");
+
+// SWAR ("SIMD within a register") helpers: eight ASCII bytes at once
+constexpr bool is_eight_digits(uint64_t chunk) {
+    // Every byte must be 0x30..0x39: high nibble 3, and adding 6 must not carry out of it
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+constexpr uint32_t parse_eight_digits(uint64_t chunk) {
+    // Little-endian load: first character in the lowest byte. Combine pairs,
+    // then quads, then the two halves (three multiplies instead of eight)
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return static_cast<uint32_t>(chunk);
+}
+
+// Strict int parser: the whole token must be an optional '-' and decimal
+// digits. No exceptions, no allocation; works on any string_view.
+Expected<int, ParseError> parse_number(std::string_view str) {
+    const char* first = str.data();
+    const char* last = first + str.size();
+    const bool negative = first != last && *first == '-';
+    const char* digits = first + negative;
+
+    // Long digit runs (same width as a 64-bit load) take the SWAR path
+    if constexpr (std::endian::native == std::endian::little) {
+        while (digits != last && *digits == '0' && last - digits > 1) ++digits; // Leading zeros
+        if (last - digits >= 8) {
+            uint64_t chunk;
+            std::memcpy(&chunk, digits, sizeof(chunk));
+            if (!is_eight_digits(chunk)) {
+                return Expected<int, ParseError>(ParseError::invalid_number);
+            }
+            if (last - digits > 10) {
+                // More than 10 significant digits: either junk or too big
+                bool all_digits = std::all_of(digits + 8, last, [](char c) { return c >= '0' && c <= '9'; });
+                return Expected<int, ParseError>(all_digits ? ParseError::out_of_range : ParseError::invalid_number);
+            }
+
+            uint64_t value = parse_eight_digits(chunk);
+            for (const char* p = digits + 8; p != last; ++p) {
+                if (*p < '0' || *p > '9') {
+                    return Expected<int, ParseError>(ParseError::invalid_number);
+                }
+                value = value * 10 + static_cast<uint64_t>(*p - '0');
+            }
+
+            const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int>::max()) + negative;
+            if (value > limit) {
+                return Expected<int, ParseError>(ParseError::out_of_range);
+            }
+            return Expected<int, ParseError>(negative ? static_cast<int>(-static_cast<int64_t>(value))
+                                                      : static_cast<int>(value));
+        }
+    }
+
+    int num = 0;
+    auto [end, ec] = std::from_chars(first, last, num);
+    if (ec == std::errc::result_out_of_range) {
+        return Expected<int, ParseError>(ParseError::out_of_range);
+    }
+    if (ec != std::errc() || end != last) {
+        return Expected<int, ParseError>(ParseError::invalid_number);
+    }
+    return Expected<int, ParseError>(num);
+}
+
+// Batch API: one result per line of a newline-delimited buffer (a trailing
+// '\r' is ignored, as is the empty tail after a final newline)
+std::vector<Expected<int, ParseError>> parse_lines(std::string_view buffer) {
+    std::vector<Expected<int, ParseError>> results;
+    results.reserve(buffer.size() / 8);
+
+    const char* p = buffer.data();
+    const char* end = p + buffer.size();
+    while (p < end) {
+        const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        const char* line_end = newline ? static_cast<const char*>(newline) : end;
+        const char* token_end = (line_end != p && line_end[-1] == '\r') ? line_end - 1 : line_end;
+        results.push_back(parse_number(std::string_view(p, static_cast<size_t>(token_end - p))));
+        p = line_end + 1;
+    }
+    return results;
 }
 
 void expected_example() {
@@ -172,6 +469,31 @@ void expected_example() {
     if (!result2.has_value()) {
         std::cout << "Error: " << result2.error() << "\n";
     }
+
+    // Monadic chaining without unwrapping by hand
+    auto halved = parse_number("84")
+        .and_then([](int n) {
+            return n % 2 == 0 ? Expected<int, ParseError>(n / 2)
+                              : Expected<int, ParseError>(unexpect, ParseError::invalid_number);
+        })
+        .transform([](int n) { return std::to_string(n) + " (halved)"; });
+    std::cout << "Chained: " << *halved << "\n";
+
+    // Batch parsing of a newline-delimited buffer
+    auto lines = parse_lines("17\n-123456789\nabc\n99999999999\n");
+    std::cout << "Batch parse:";
+    for (const auto& line : lines) {
+        if (line) {
+            std::cout << " " << *line;
+        } else {
+            std::cout << " [" << line.error() << "]";
+        }
+    }
+    std::cout << "\n";
+
+    // In-place construction of a non-trivial value
+    Expected<std::string, ParseError> built(std::in_place, 3, '!');
+    std::cout << "In-place value: " << *built << "\n";
 }
 
 // 5. IMPROVED CONSTEXPR (More capabilities)
@@ -265,20 +587,75 @@ void improved_ranges_example() {
 // ============================================================================
 // Proposed improvements for better lifetime management
 
+// Bounds-check policies: `enabled` says whether a check is emitted at all,
+// `violation()` what happens when it fails
+struct CheckedAccess {
+    static constexpr bool enabled = true;
+    [[noreturn]] static void violation() { throw std::out_of_range("Index out of bounds"); }
+};
+
+// Checked in debug builds only (compiled out with NDEBUG, like assert)
+struct DebugAssertAccess {
+#ifdef NDEBUG
+    static constexpr bool enabled = false;
+#else
+    static constexpr bool enabled = true;
+#endif
+    [[noreturn]] static void violation() {
+        assert(!"Index out of bounds");
+        std::abort();
+    }
+};
+
+struct UncheckedAccess {
+    static constexpr bool enabled = false;
+    [[noreturn]] static void violation() { std::abort(); }
+};
+
+// Always checked, but fails with a single trap instruction: no exception
+// tables or message strings on the hot path
+struct HardenedTrapAccess {
+    static constexpr bool enabled = true;
+    [[noreturn]] static void violation() { __builtin_trap(); }
+};
+
+template<typename Policy = CheckedAccess>
 class SafeContainer {
 private:
     std::vector<int> data;
+
+    static constexpr void check(bool in_bounds) {
+        if constexpr (Policy::enabled) {
+            if (!in_bounds) [[unlikely]] {
+                Policy::violation();
+            }
+        }
+    }
     
 public:
     SafeContainer() : data{1, 2, 3, 4, 5} {}
+    explicit SafeContainer(std::vector<int> values) : data(std::move(values)) {}
+
+    size_t size() const { return data.size(); }
     
-    // Bounds-checked access proposed for C++26
-    int safe_get(size_t index) {
-        if (index >= data.size()) {
-            throw std::out_of_range("Index out of bounds");
-        }
+    // Bounds-checked access (per the policy)
+    int safe_get(size_t index) const {
+        check(index < data.size());
         return data[index];
     }
+
+    // Bulk access: the range [first, first + count) is validated once and
+    // the loop over the returned span needs no further checks
+    std::span<const int> safe_range(size_t first, size_t count) const {
+        check(first <= data.size() && count <= data.size() - first);
+        return std::span<const int>(data).subspan(first, count);
+    }
+
+    // Copy out.size() elements starting at first with one check
+    void copy_to(size_t first, std::span<int> out) const {
+        std::span<const int> source = safe_range(first, out.size());
+        std::copy(source.begin(), source.end(), out.begin());
+    }
 };
 
 void lifetime_safety_example() {
@@ -291,6 +668,22 @@ void lifetime_safety_example() {
     } catch (const std::exception& e) {
         std::cout << "Error: " << e.what() << "\n";
     }
+
+    // Hoisted check: validate the window once, then iterate freely
+    SafeContainer<HardenedTrapAccess> hardened;
+    int window_sum = 0;
+    for (int v : hardened.safe_range(1, 3)) {
+        window_sum += v;
+    }
+    std::cout << "Sum of elements [1, 4) with one range check: " << window_sum << "\n";
+
+    // Unchecked policy for proven-safe hot loops: no branch at all
+    SafeContainer<UncheckedAccess> fast;
+    int total = 0;
+    for (size_t i = 0; i < fast.size(); ++i) {
+        total += fast.safe_get(i);
+    }
+    std::cout << "Unchecked total: " << total << "\n";
 }
 
 // 10. IMPROVED TEMPLATE METAPROGRAMMING
@@ -322,6 +715,8 @@ void coroutines_comment() {
     std::cout << "C++26 will have better coroutine support and utilities\n";
     std::cout << "- Cleaner coroutine APIs\n";
     std::cout << "- Better integration with standard library\n";
+    std::cout << "- Until std::generator (C++23) ships everywhere, build_bst.cpp has a\n";
+    std::cout << "  hand-rolled Generator<T> with lazy inorder/preorder/inorderRange walks\n";
 }
 
 // 12. ATTRIBUTES EXPANSION
@@ -342,6 +737,8 @@ void attributes_example() {
     // critical_function();  // Would trigger warning
 }
 
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 // Main function
 int main() {
     std::cout << "=== C++26 FEATURES SHOWCASE (Proposed/Future) ===";
@@ -365,3 +762,4 @@ int main() {
     
     return 0;
 }
+#endif // CODESTUDIO_NO_MAIN
@@ -2,6 +2,15 @@
 #include <vector>
 #include <algorithm> // For std::max, std::lower_bound, std::distance
 #include <functional> // For std::greater
+#include <span>
+#include <concepts>
+#include <unordered_map>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 // Function to find the peak index in a mountain array
 int findPeakIndex(const std::vector<int>& arr) {
@@ -22,48 +31,414 @@ int findPeakIndex(const std::vector<int>& arr) {
     return left; // 'left' will be the peak index
 }
 
-// Function to perform binary search in an ascending sorted array using std::lower_bound
-int binarySearchAscending(const std::vector<int>& arr, int target, int left, int right) {
-    auto it = std::lower_bound(arr.begin() + left, arr.begin() + right + 1, target);
-    if (it != arr.begin() + right + 1 && *it == target) {
-        return std::distance(arr.begin(), it);
+// Below this many elements the remaining range is scanned with vector
+// compares instead of being halved further; halving steps mispredict or
+// stall on a dependent load, a 32-element scan is four AVX2 compares.
+constexpr int kLinearWindow = 32;
+
+// Number of leading elements of a sorted window that come before target:
+// elements < target for ascending order, > target for descending order.
+// Because the window is sorted this is exactly the lower_bound offset.
+template<bool Descending>
+int countBeforeScalar(const int* window, int count, int target) {
+    int before = 0;
+    for (int i = 0; i < count; ++i) {
+        before += Descending ? window[i] > target : window[i] < target;
     }
-    return -1; // Target not found
+    return before;
 }
 
-// Function to perform binary search in a descending sorted array using std::lower_bound with a custom comparator
-int binarySearchDescending(const std::vector<int>& arr, int target, int left, int right) {
-    // std::lower_bound finds the first element not less than value.
-    // For a descending array, "not less than" means equal or greater than the target.
-    // We need to find the first element that is <= target.
-    // Using std::greater<int>() reverses the comparison, so it effectively finds
-    // the first element x such that !(x > target), i.e., x <= target.
-    auto it = std::lower_bound(arr.begin() + left, arr.begin() + right + 1, target, std::greater<int>());
-    if (it != arr.begin() + right + 1 && *it == target) {
-        return std::distance(arr.begin(), it);
+#if defined(__x86_64__) || defined(__i386__)
+template<bool Descending>
+__attribute__((target("avx2,popcnt")))
+int countBeforeAvx2(const int* window, int count, int target) {
+    const __m256i needle = _mm256_set1_epi32(target);
+    int before = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(window + i));
+        __m256i mask = Descending ? _mm256_cmpgt_epi32(values, needle) : _mm256_cmpgt_epi32(needle, values);
+        before += _mm_popcnt_u32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask))));
+    }
+    return before + countBeforeScalar<Descending>(window + i, count - i, target);
+}
+#elif defined(__ARM_NEON)
+template<bool Descending>
+int countBeforeNeon(const int* window, int count, int target) {
+    const int32x4_t needle = vdupq_n_s32(target);
+    uint32x4_t hits = vdupq_n_u32(0);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int32x4_t values = vld1q_s32(window + i);
+        uint32x4_t mask = Descending ? vcgtq_s32(values, needle) : vcltq_s32(values, needle);
+        hits = vsubq_u32(hits, mask); // Lanes are all-ones (-1) on a hit
+    }
+    return static_cast<int>(vaddvq_u32(hits)) + countBeforeScalar<Descending>(window + i, count - i, target);
+}
+#endif
+
+// Picked once per process from the CPU's features
+template<bool Descending>
+int countBefore(const int* window, int count, int target) {
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    if (has_avx2) {
+        return countBeforeAvx2<Descending>(window, count, target);
+    }
+    return countBeforeScalar<Descending>(window, count, target);
+#elif defined(__ARM_NEON)
+    return countBeforeNeon<Descending>(window, count, target);
+#else
+    return countBeforeScalar<Descending>(window, count, target);
+#endif
+}
+
+// Hybrid lower_bound on arr[left..right]: branchless halving down to at
+// most Window elements, then one vector scan of the window.
+// Returns the index of target, or -1 if it is not present.
+template<bool Descending, int Window = kLinearWindow>
+int hybridSearch(const std::vector<int>& arr, int target, int left, int right) {
+    if (left > right) {
+        return -1;
+    }
+
+    const int* base = arr.data() + left;
+    int len = right - left + 1;
+    while (len > Window) {
+        int half = len / 2;
+        // Everything up to base[half] comes before target, so skip it
+        bool before = Descending ? base[half] > target : base[half] < target;
+        base = before ? base + half : base;
+        len -= half;
+    }
+
+    int index = static_cast<int>(base - arr.data()) + countBefore<Descending>(base, len, target);
+    if (index <= right && arr[index] == target) {
+        return index;
     }
     return -1; // Target not found
 }
 
+// Binary search in an ascending sorted range
+int binarySearchAscending(const std::vector<int>& arr, int target, int left, int right) {
+    return hybridSearch<false>(arr, target, left, right);
+}
+
+// Binary search in a descending sorted range: the first element that is
+// not greater than target is where it would be, as with
+// std::lower_bound(..., std::greater<int>())
+int binarySearchDescending(const std::vector<int>& arr, int target, int left, int right) {
+    return hybridSearch<true>(arr, target, left, right);
+}
+
+// Reusable index over a fixed mountain array: the peak is found once at
+// construction, so each query is just the two binary searches. All members
+// are const after construction, so one instance can be shared read-only
+// across threads. The array must outlive the index.
+class MountainIndex {
+public:
+    explicit MountainIndex(const std::vector<int>& arr)
+        : arr_(&arr), peak_(arr.empty() ? -1 : findPeakIndex(arr)) {}
+    // The index only points at the array, so a temporary would dangle
+    explicit MountainIndex(std::vector<int>&&) = delete;
+
+    int peak() const { return peak_; }
+
+    // Smallest index holding target, or -1 if it is not present
+    int find(int target) const {
+        if (arr_->empty()) {
+            return -1;
+        }
+
+        // Search in the left (ascending) part including the peak
+        int result = binarySearchAscending(*arr_, target, 0, peak_);
+        if (result != -1) {
+            return result;
+        }
+
+        // Search in the right (descending) part
+        return binarySearchDescending(*arr_, target, peak_ + 1, arr_->size() - 1);
+    }
+
+    // results[i] = find(targets[i]); throws std::invalid_argument if results
+    // is shorter than targets. Targets go in groups of kGroup whose binary
+    // searches advance in lock-step (every lane of a run has the same length),
+    // so their cache misses overlap instead of being paid one after another.
+    void find_many(std::span<const int> targets, std::span<int> results) const {
+        if (results.size() < targets.size()) {
+            throw std::invalid_argument("MountainIndex::find_many: results is shorter than targets");
+        }
+        if (arr_->empty()) {
+            std::fill(results.begin(), results.begin() + targets.size(), -1);
+            return;
+        }
+
+        const int* data = arr_->data();
+        const size_t ascending = static_cast<size_t>(peak_) + 1; // [0, peak]
+        const size_t n = arr_->size();
+        const int* hits[kGroup];
+
+        for (size_t first = 0; first < targets.size(); first += kGroup) {
+            const size_t count = std::min(kGroup, targets.size() - first);
+            const int* group = targets.data() + first;
+
+            lowerBoundGroup<false>(data, ascending, group, count, hits);
+            size_t misses = 0;
+            for (size_t i = 0; i < count; ++i) {
+                bool found = hits[i] < data + ascending && *hits[i] == group[i];
+                results[first + i] = found ? static_cast<int>(hits[i] - data) : -1;
+                misses += !found;
+            }
+            if (misses == 0 || ascending == n) {
+                continue;
+            }
+
+            // Descending run (peak, n): the whole group again, so the lanes
+            // stay in lock-step; lanes that already hit keep their answer
+            lowerBoundGroup<true>(data + ascending, n - ascending, group, count, hits);
+            for (size_t i = 0; i < count; ++i) {
+                if (results[first + i] == -1 && hits[i] < data + n && *hits[i] == group[i]) {
+                    results[first + i] = static_cast<int>(hits[i] - data);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kGroup = 16;
+
+    // Branchless lower_bound of each target in the same sorted run
+    // [base, base + len); out[i] may be base + len (not found)
+    template<bool Descending>
+    static void lowerBoundGroup(const int* base, size_t len, const int* targets, size_t count, const int** out) {
+        auto before = [](int value, int target) { return Descending ? value > target : value < target; };
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = base;
+        }
+        if (len == 0) {
+            return;
+        }
+        while (len > 1) {
+            const size_t half = len / 2;
+            len -= half;
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = before(out[i][half], targets[i]) ? out[i] + half : out[i];
+                __builtin_prefetch(out[i] + len / 2);
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            out[i] += before(*out[i], targets[i]);
+        }
+    }
+
+    const std::vector<int>* arr_;
+    int peak_;
+};
+
 // Main function to find target in a mountain array
 int findTargetInMountainArray(const std::vector<int>& arr, int target) {
-    if (arr.empty()) {
+    return MountainIndex(arr).find(target);
+}
+
+// Mountain array behind an accessor (LeetCode-style MountainArray), e.g. an
+// RPC stub where every get(i) is a round trip
+template<typename A>
+concept MountainAccessor = requires(A& a, int i) {
+    { a.get(i) } -> std::convertible_to<int>;
+    { a.length() } -> std::convertible_to<int>;
+};
+
+// Accessors that can fetch several indices in one round trip
+template<typename A>
+concept BatchMountainAccessor = MountainAccessor<A> &&
+    requires(A& a, std::span<const int> indices, std::span<int> values) {
+        a.get_many(indices, values);
+    };
+
+// Memoizing front for a MountainAccessor. Each index is fetched at most
+// once, and with a batching accessor every fetch also brings in the probes
+// of the next speculation_depth search levels, whichever way they go, so a
+// search needs roughly 1/(depth + 1) of the round trips.
+// Not thread-safe: use one cache per thread (or per query sequence).
+template<MountainAccessor A>
+class ProbeCache {
+public:
+    explicit ProbeCache(A& accessor, int speculation_depth = 2)
+        : accessor_(&accessor), depth_(speculation_depth) {}
+
+    int length() {
+        if (length_ < 0) {
+            length_ = accessor_->length();
+            ++round_trips_;
+        }
+        return length_;
+    }
+
+    bool contains(int index) const { return values_.contains(index); }
+
+    int get(int index) {
+        auto it = values_.find(index);
+        if (it != values_.end()) {
+            return it->second;
+        }
+        int value = accessor_->get(index);
+        ++round_trips_;
+        ++probes_;
+        values_.emplace(index, value);
+        return value;
+    }
+
+    // Fetch all uncached indices in a single round trip (batching accessors only)
+    void prefetch(std::span<const int> indices) {
+        if constexpr (BatchMountainAccessor<A>) {
+            std::vector<int> missing;
+            for (int index : indices) {
+                if (!values_.contains(index) && std::find(missing.begin(), missing.end(), index) == missing.end()) {
+                    missing.push_back(index);
+                }
+            }
+            if (missing.empty()) {
+                return;
+            }
+            std::vector<int> fetched(missing.size());
+            accessor_->get_many(missing, fetched);
+            ++round_trips_;
+            probes_ += missing.size();
+            for (size_t i = 0; i < missing.size(); ++i) {
+                values_.emplace(missing[i], fetched[i]);
+            }
+        }
+    }
+
+    int speculation_depth() const {
+        return BatchMountainAccessor<A> ? depth_ : 0;
+    }
+
+    size_t round_trips() const { return round_trips_; }
+    size_t probes() const { return probes_; }
+
+private:
+    A* accessor_;
+    int depth_;
+    int length_ = -1;
+    size_t round_trips_ = 0;
+    size_t probes_ = 0;
+    std::unordered_map<int, int> values_;
+};
+
+// Probes a peak search on [left, right] will make over the next `depth`
+// levels, on both sides of every comparison
+void speculatePeak(int left, int right, int depth, std::vector<int>& out) {
+    if (left >= right || depth < 0) return;
+    int mid = left + (right - left) / 2;
+    out.push_back(mid);
+    out.push_back(mid + 1);
+    speculatePeak(mid + 1, right, depth - 1, out);
+    speculatePeak(left, mid, depth - 1, out);
+}
+
+// Same for a lower_bound on the half-open range [left, right)
+void speculateLowerBound(int left, int right, int depth, std::vector<int>& out) {
+    if (left >= right || depth < 0) return;
+    int mid = left + (right - left) / 2;
+    out.push_back(mid);
+    speculateLowerBound(mid + 1, right, depth - 1, out);
+    speculateLowerBound(left, mid, depth - 1, out);
+}
+
+// lower_bound on [left, right] for ascending (or descending) values, then
+// an equality check. Returns the index of target, or -1.
+template<bool Descending, MountainAccessor A>
+int probeSearch(ProbeCache<A>& cache, int target, int left, int right) {
+    int end = right + 1;
+    std::vector<int> plan;
+    while (left < end) {
+        int mid = left + (end - left) / 2;
+        // Only go remote when the probe is needed anyway, and bring the
+        // next levels along in the same round trip
+        if (cache.speculation_depth() > 0 && !cache.contains(mid)) {
+            plan.clear();
+            speculateLowerBound(left, end, cache.speculation_depth(), plan);
+            cache.prefetch(plan);
+        }
+        int value = cache.get(mid);
+        bool before = Descending ? value > target : value < target;
+        if (before) {
+            left = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    if (left <= right && cache.get(left) == target) {
+        return left;
+    }
+    return -1;
+}
+
+// Find target through a probe cache. Reusing the cache across queries on
+// the same array answers repeated probes (the peak search in particular)
+// without any round trips.
+template<MountainAccessor A>
+int findTargetInMountainArray(ProbeCache<A>& cache, int target) {
+    int n = cache.length();
+    if (n == 0) {
         return -1;
     }
 
-    int peakIndex = findPeakIndex(arr);
+    int left = 0;
+    int right = n - 1;
+    std::vector<int> plan;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (cache.speculation_depth() > 0 && !(cache.contains(mid) && cache.contains(mid + 1))) {
+            plan.clear();
+            speculatePeak(left, right, cache.speculation_depth(), plan);
+            cache.prefetch(plan);
+        }
+        if (cache.get(mid) < cache.get(mid + 1)) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    int peakIndex = left;
 
-    // Search in the left (ascending) part including the peak
-    int result = binarySearchAscending(arr, target, 0, peakIndex);
+    int result = probeSearch<false>(cache, target, 0, peakIndex);
     if (result != -1) {
         return result;
     }
+    return probeSearch<true>(cache, target, peakIndex + 1, n - 1);
+}
 
-    // Search in the right (descending) part
-    return binarySearchDescending(arr, target, peakIndex + 1, arr.size() - 1);
+// One-shot overload for a remote/lazy mountain array
+template<MountainAccessor A>
+int findTargetInMountainArray(A& mountain, int target) {
+    ProbeCache<A> cache(mountain);
+    return findTargetInMountainArray(cache, target);
 }
 
+// Local stand-in for a remote mountain array that counts accessor calls
+struct CountingMountainArray {
+    const std::vector<int>& data;
+    int calls = 0;
+
+    int get(int index) {
+        ++calls;
+        return data[index];
+    }
+
+    int length() const { return static_cast<int>(data.size()); }
+
+    void get_many(std::span<const int> indices, std::span<int> values) {
+        ++calls;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            values[i] = data[indices[i]];
+        }
+    }
+};
 
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 int main() {
     std::vector<int> mountainArr = {1, 3, 5, 8, 7, 4, 2};
     int target = 4; // Example target
@@ -113,5 +488,29 @@ int main() {
         std::cout << "Target " << target5 << " not found in the array." << std::endl;
     }
 
+    // Reusable index: peak computed once, many queries
+    MountainIndex mountainIndex(mountainArr);
+    std::vector<int> queries = {1, 8, 4, 2, 6};
+    std::vector<int> answers(queries.size());
+    mountainIndex.find_many(queries, answers);
+    std::cout << "Batched queries (peak at " << mountainIndex.peak() << "):";
+    for (size_t i = 0; i < queries.size(); ++i) {
+        std::cout << " " << queries[i] << "->" << answers[i];
+    }
+    std::cout << std::endl;
+
+    // Lazy accessor: count round trips with and without speculative prefetch
+    std::vector<int> bigMountain;
+    for (int i = 0; i < 600; ++i) bigMountain.push_back(i);
+    for (int i = 599; i > 0; --i) bigMountain.push_back(i - 600);
+    for (int depth : {0, 2}) {
+        CountingMountainArray remote{bigMountain};
+        ProbeCache<CountingMountainArray> cache(remote, depth);
+        int found = findTargetInMountainArray(cache, -250);
+        std::cout << "Accessor search (speculation depth " << depth << "): index " << found
+                  << ", " << cache.round_trips() << " round trips, " << cache.probes() << " probes" << std::endl;
+    }
+
     return 0;
-}
\ No newline at end of file
+}
+#endif // CODESTUDIO_NO_MAIN
@@ -1,36 +1,254 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <span>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <functional>
+#include <ranges>
+#include <iterator>
+#include <compare>
+#include <stdexcept>
 
-int search(const std::vector<int>& nums, int target) {
-    int left = 0;
-    int right = nums.size() - 1;
+// Generic version: works in place on any contiguous keys (64-bit IDs,
+// memory-mapped uint32_t files, ...) without copying into a vector<int>.
+// comp must be a strict weak order the array is sorted by before rotation;
+// two keys are equal when neither compares less than the other.
+// Returns the index of target, or -1 if it is not present.
+template<typename T, typename Compare>
+requires std::strict_weak_order<Compare&, const T&, const T&>
+std::ptrdiff_t search(std::span<const T> nums, const T& target, Compare comp) {
+    size_t left = 0;
+    size_t right = nums.size(); // Half-open [left, right) so indices never go negative
 
-    while (left <= right) {
-        int mid = left + (right - left) / 2;
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        const T& value = nums[mid];
 
-        if (nums[mid] == target) {
-            return mid;
+        if (!comp(value, target) && !comp(target, value)) {
+            return static_cast<std::ptrdiff_t>(mid);
         }
 
         // Determine which half is sorted
-        if (nums[left] <= nums[mid]) { // Left half is sorted
-            if (target >= nums[left] && target < nums[mid]) {
-                right = mid - 1;
+        if (!comp(value, nums[left])) { // Left half is sorted
+            if (!comp(target, nums[left]) && comp(target, value)) {
+                right = mid;
             } else {
                 left = mid + 1;
             }
         } else { // Right half is sorted
-            if (target > nums[mid] && target <= nums[right]) {
+            if (comp(value, target) && !comp(nums[right - 1], target)) {
                 left = mid + 1;
             } else {
-                right = mid - 1;
+                right = mid;
             }
         }
     }
     return -1; // Target not found
 }
 
+template<std::totally_ordered T>
+std::ptrdiff_t search(std::span<const T> nums, const T& target) {
+    return search(nums, target, std::ranges::less{});
+}
+
+int search(const std::vector<int>& nums, int target) {
+    return static_cast<int>(search(std::span<const int>(nums), target));
+}
+
+// Index of the smallest element, i.e. how far the sorted array was rotated.
+// O(log n); like search(), assumes distinct values.
+template<typename T, typename Compare = std::ranges::less>
+requires std::strict_weak_order<Compare&, const T&, const T&>
+size_t findRotationPivot(std::span<const T> nums, Compare comp = {}) {
+    size_t left = 0;
+    size_t right = nums.empty() ? 0 : nums.size() - 1;
+
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        if (comp(nums[right], nums[mid])) {
+            left = mid + 1; // Minimum is right of mid
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+// Rotated array presented in its sorted order. The pivot is found once, in
+// O(log n); afterwards logical position i is physical index (pivot + i) mod n,
+// so the view is a random-access range and std::ranges::lower_bound,
+// equal_range, binary_search, ... work on it directly. Non-owning, like
+// std::span; the same distinct-values assumption as findRotationPivot applies.
+template<typename T, typename Compare = std::ranges::less>
+requires std::strict_weak_order<Compare&, const T&, const T&>
+class RotatedView : public std::ranges::view_interface<RotatedView<T, Compare>> {
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = const T&;
+        using pointer = const T*;
+
+        iterator() = default;
+        iterator(std::span<const T> data, size_t pivot, difference_type pos)
+            : data_(data.data()), size_(data.size()), pivot_(pivot), pos_(pos) {}
+
+        reference operator*() const { return data_[physical_index()]; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+        pointer operator->() const { return &**this; }
+
+        iterator& operator++() { ++pos_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++pos_; return tmp; }
+        iterator& operator--() { --pos_; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --pos_; return tmp; }
+        iterator& operator+=(difference_type n) { pos_ += n; return *this; }
+        iterator& operator-=(difference_type n) { pos_ -= n; return *this; }
+
+        friend iterator operator+(iterator it, difference_type n) { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b) { return a.pos_ - b.pos_; }
+        friend bool operator==(const iterator& a, const iterator& b) { return a.pos_ == b.pos_; }
+        friend auto operator<=>(const iterator& a, const iterator& b) { return a.pos_ <=> b.pos_; }
+
+        // Index of this element in the underlying (rotated) array
+        size_t physical_index() const {
+            size_t index = pivot_ + static_cast<size_t>(pos_);
+            return index >= size_ ? index - size_ : index;
+        }
+
+    private:
+        // Self-contained (no pointer back to the view), so iterators stay
+        // valid when the view is copied or was a temporary
+        const T* data_ = nullptr;
+        size_t size_ = 0;
+        size_t pivot_ = 0;
+        difference_type pos_ = 0;
+    };
+
+    RotatedView() = default;
+    explicit RotatedView(std::span<const T> data, Compare comp = {})
+        : data_(data), pivot_(findRotationPivot(data, comp)), comp_(comp) {}
+
+    iterator begin() const { return iterator(data_, pivot_, 0); }
+    iterator end() const { return iterator(data_, pivot_, static_cast<std::ptrdiff_t>(data_.size())); }
+    size_t size() const { return data_.size(); }
+
+    // How far the sorted array was rotated (index of its smallest element)
+    size_t pivot() const { return pivot_; }
+
+    size_t physical_index(size_t logical) const {
+        size_t index = pivot_ + logical;
+        return index >= data_.size() ? index - data_.size() : index;
+    }
+
+    // i-th smallest element
+    const T& operator[](size_t logical) const { return data_[physical_index(logical)]; }
+
+    // Physical index of target, or -1, like search()
+    std::ptrdiff_t find(const T& target) const {
+        auto it = std::ranges::lower_bound(*this, target, comp_);
+        if (it == end() || comp_(target, *it)) {
+            return -1;
+        }
+        return static_cast<std::ptrdiff_t>(it.physical_index());
+    }
+
+    // Number of keys in the closed interval [low, high]: two binary searches
+    size_t count(const T& low, const T& high) const {
+        if (comp_(high, low)) {
+            return 0;
+        }
+        auto first = std::ranges::lower_bound(*this, low, comp_);
+        auto last = std::ranges::upper_bound(first, end(), high, comp_);
+        return static_cast<size_t>(last - first);
+    }
+
+private:
+    std::span<const T> data_;
+    size_t pivot_ = 0;
+    [[no_unique_address]] Compare comp_;
+};
+
+template<typename T, typename Allocator>
+RotatedView(const std::vector<T, Allocator>&) -> RotatedView<T>;
+
+template<typename T, typename Compare>
+inline constexpr bool std::ranges::enable_borrowed_range<RotatedView<T, Compare>> = true;
+
+static_assert(std::ranges::random_access_range<RotatedView<int>>);
+static_assert(std::ranges::view<RotatedView<int>>);
+
+// Answer many lookups against the same rotated array. The pivot is found
+// once; after that each target picks its sorted run ([pivot, n) or
+// [0, pivot)) and does a branchless lower_bound in it. Targets are processed
+// in groups whose searches advance in lock-step, so their cache misses
+// overlap instead of being paid one after another.
+// results[i] is the index of targets[i], or -1 if it is not present;
+// throws std::invalid_argument if results is shorter than targets.
+void searchMany(const std::vector<int>& nums, std::span<const int> targets, std::span<int> results) {
+    if (results.size() < targets.size()) {
+        throw std::invalid_argument("searchMany: results is shorter than targets");
+    }
+    constexpr size_t kGroup = 16;
+    const size_t n = nums.size();
+    if (n == 0) {
+        std::fill(results.begin(), results.begin() + targets.size(), -1);
+        return;
+    }
+
+    const size_t pivot = findRotationPivot(std::span<const int>(nums));
+    const int last = nums[n - 1];
+    const int* data = nums.data();
+
+    const int* base[kGroup];
+    size_t len[kGroup];
+
+    for (size_t first = 0; first < targets.size(); first += kGroup) {
+        const size_t count = std::min(kGroup, targets.size() - first);
+        size_t longest = 1;
+
+        for (size_t i = 0; i < count; ++i) {
+            // Keys <= last element live in the right run [pivot, n)
+            bool in_right_run = targets[first + i] <= last;
+            base[i] = in_right_run ? data + pivot : data;
+            len[i] = in_right_run ? n - pivot : pivot;
+            if (len[i] == 0) {
+                // Unrotated array and target above the maximum: probe a
+                // real element so the lane stays harmless; it cannot match
+                base[i] = data + n - 1;
+                len[i] = 1;
+            }
+            longest = std::max(longest, len[i]);
+        }
+
+        // Every lane runs the same number of halving steps; lanes that are
+        // already down to one element just re-read it
+        for (int step = 0, steps = std::bit_width(longest); step < steps; ++step) {
+            for (size_t i = 0; i < count; ++i) {
+                size_t half = len[i] / 2;
+                base[i] = base[i][half] < targets[first + i] ? base[i] + half : base[i];
+                len[i] -= half;
+                __builtin_prefetch(base[i] + len[i] / 2);
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const int* hit = base[i] + (*base[i] < targets[first + i]);
+            bool found = hit < data + n && *hit == targets[first + i];
+            results[first + i] = found ? static_cast<int>(hit - data) : -1;
+        }
+    }
+}
+
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 int main() {
     std::vector<int> nums1 = {4, 5, 6, 7, 0, 1, 2};
     int target1 = 0;
@@ -52,5 +270,37 @@ int main() {
     int target5 = 1;
     std::cout << "Target " << target5 << " found at index: " << search(nums5, target5) << std::endl;
 
+    // Many targets against one rotated array
+    std::vector<int> rotated = {15, 18, 21, 2, 3, 5, 8, 11};
+    std::vector<int> targets = {2, 21, 11, 4, 15, 30, 8, 1};
+    std::vector<int> indices(targets.size());
+    searchMany(rotated, targets, indices);
+    std::cout << "Batched search (pivot " << findRotationPivot(std::span<const int>(rotated)) << "):";
+    for (size_t i = 0; i < targets.size(); ++i) {
+        std::cout << " " << targets[i] << "->" << indices[i];
+    }
+    std::cout << std::endl;
+
+    // Pivot found once; the view then behaves like the sorted array
+    RotatedView view(rotated);
+    std::cout << "Rotated view (pivot " << view.pivot() << "):";
+    for (int value : view) {
+        std::cout << " " << value;
+    }
+    std::cout << std::endl;
+    std::cout << "View find(8) -> " << view.find(8) << ", keys in [4, 16]: " << view.count(4, 16)
+              << ", binary_search(18): " << std::ranges::binary_search(view, 18) << std::endl;
+
+    // Generic search over 64-bit IDs in place, and with a custom comparator
+    const std::uint64_t ids[] = {40'000'000'000, 50'000'000'000, 10'000'000'000, 20'000'000'000};
+    std::cout << "64-bit id found at index: "
+              << search(std::span<const std::uint64_t>(ids), std::uint64_t{10'000'000'000}) << std::endl;
+
+    // Descending array rotated: {3, 2, 1, 6, 5, 4}
+    const int descending[] = {3, 2, 1, 6, 5, 4};
+    std::cout << "Target 5 in descending rotated array found at index: "
+              << search(std::span<const int>(descending), 5, std::greater<int>{}) << std::endl;
+
     return 0;
-}
\ No newline at end of file
+}
+#endif // CODESTUDIO_NO_MAIN
@@ -4,6 +4,17 @@
 #include <limits>
 #include <concepts>
 #include <string> // Added for std::string test
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <stop_token>
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <string_view>
+#include <compare>
+#include <cstring>
+#include <cstdint>
 
 // C++20 Concept to ensure value type is ordered and supports comparison
 template<typename T>
@@ -24,12 +35,143 @@ struct TreeNode {
     TreeNode(const T& x) : val(x), left(nullptr), right(nullptr) {}
 };
 
+// Backing store for StringKey bytes: strings are copied into large shared
+// blocks instead of one heap buffer per key, and stay put until the arena
+// goes away.
+class StringArena {
+public:
+    explicit StringArena(size_t block_bytes = 64 * 1024) : block_bytes_(block_bytes) {}
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::string_view store(std::string_view text) {
+        if (text.size() > free_) {
+            // Oversized strings get a block of their own
+            size_t bytes = std::max(block_bytes_, text.size());
+            blocks_.push_back(std::make_unique<char[]>(bytes));
+            next_ = blocks_.back().get();
+            free_ = bytes;
+        }
+        char* copy = next_;
+        if (!text.empty()) { // data() may be null for an empty view
+            std::memcpy(copy, text.data(), text.size());
+        }
+        next_ += text.size();
+        free_ -= text.size();
+        return {copy, text.size()};
+    }
+
+private:
+    size_t block_bytes_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* next_ = nullptr;
+    size_t free_ = 0;
+};
+
+// String key laid out for fast comparison: the first 8 bytes are kept
+// inline in the node as a big-endian integer, so most comparisons are one
+// integer compare with no pointer chase. Only keys sharing those 8 bytes
+// fall back to comparing the rest of the bytes in the arena. Orders exactly
+// like std::string (bytes compared as unsigned char). Trivially copyable;
+// the arena that stores the bytes must outlive the key.
+class StringKey {
+public:
+    StringKey(std::string_view text, StringArena& arena)
+        : prefix_(loadPrefix(text)), size_(text.size()), data_(arena.store(text).data()) {}
+
+    std::string_view view() const { return {data_, size_}; }
+    size_t size() const { return size_; }
+
+    friend std::strong_ordering operator<=>(const StringKey& a, const StringKey& b) noexcept {
+        if (a.prefix_ != b.prefix_) {
+            return a.prefix_ <=> b.prefix_;
+        }
+        // Prefixes tie: the first min(size, 8) bytes are equal
+        const size_t common = std::min(a.size_, b.size_);
+        if (common > kPrefixBytes) {
+            int cmp = std::memcmp(a.data_ + kPrefixBytes, b.data_ + kPrefixBytes, common - kPrefixBytes);
+            if (cmp != 0) {
+                return cmp <=> 0;
+            }
+        }
+        return a.size_ <=> b.size_;
+    }
+
+    friend bool operator==(const StringKey& a, const StringKey& b) noexcept {
+        return a.prefix_ == b.prefix_ && a.size_ == b.size_ && a.view() == b.view();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const StringKey& key) { return os << key.view(); }
+
+private:
+    static constexpr size_t kPrefixBytes = sizeof(uint64_t);
+
+    // Zero-padded, so a shorter key sorts first when its bytes match
+    static uint64_t loadPrefix(std::string_view text) {
+        unsigned char bytes[kPrefixBytes] = {};
+        if (!text.empty()) {
+            std::memcpy(bytes, text.data(), std::min(text.size(), kPrefixBytes));
+        }
+        uint64_t prefix = 0;
+        for (unsigned char byte : bytes) {
+            prefix = (prefix << 8) | byte;
+        }
+        return prefix;
+    }
+
+    uint64_t prefix_;
+    size_t size_;
+    const char* data_;
+};
+
+// Traversal policies for isValidBST
+// HeapStackTraversal: std::stack of the left spine (default)
+// InlineStackTraversal<N>: fixed-capacity stack inside the call frame, no
+//   allocation for trees up to N deep. A deeper tree overflows it and the
+//   whole check restarts as HeapStackTraversal, so it allocates after all
+//   and pays for the partial walk. Pick N above the expected height.
+//   Never modifies the tree
+// MorrisTraversal: threads predecessor links temporarily, O(1) extra memory.
+//   The tree is modified while validating (and restored before returning),
+//   so it must not be read concurrently.
+struct HeapStackTraversal {};
+
+template<size_t N>
+struct InlineStackTraversal {
+    static constexpr size_t capacity = N;
+};
+
+struct MorrisTraversal {};
+
+// Verdict of a validation pass plus the first offending node found.
+// offending is nullptr when the tree is valid.
+template<typename T>
+struct ValidationResult {
+    bool valid;
+    const TreeNode<T>* offending;
+
+    explicit operator bool() const { return valid; }
+};
+
 template<Ordered T> // Apply the Ordered concept to the Solution class template parameter
 class Solution {
 public:
     // Validate if the tree is a Binary Search Tree
     // Uses raw pointer for traversal to avoid ownership transfer issues
+    template<typename Traversal = HeapStackTraversal>
     bool isValidBST(const std::unique_ptr<TreeNode<T>>& root) {
+        if constexpr (std::is_same_v<Traversal, MorrisTraversal>) {
+            return isValidBSTMorris(root.get());
+        } else if constexpr (requires { Traversal::capacity; }) {
+            return isValidBSTInline<Traversal::capacity>(root);
+        } else {
+            return isValidBSTHeap(root);
+        }
+    }
+
+    // In-order walk with the left spine on a std::stack
+    bool isValidBSTHeap(const std::unique_ptr<TreeNode<T>>& root) {
         std::stack<TreeNode<T>*> stack;
         TreeNode<T>* curr = root.get();
         TreeNode<T>* prev = nullptr;
@@ -53,8 +195,168 @@ public:
         }
         return true;
     }
+
+    // Same in-order walk with the spine kept in a fixed-size array
+    template<size_t N>
+    bool isValidBSTInline(const std::unique_ptr<TreeNode<T>>& root) {
+        std::array<TreeNode<T>*, N> stack;
+        size_t depth = 0;
+        TreeNode<T>* curr = root.get();
+        TreeNode<T>* prev = nullptr;
+
+        while (curr != nullptr || depth != 0) {
+            while (curr != nullptr) {
+                if (depth == N) {
+                    // Too deep for the inline stack: restart on the heap
+                    // one (Morris would write to a tree the caller may be
+                    // sharing with other readers)
+                    return isValidBSTHeap(root);
+                }
+                stack[depth++] = curr;
+                curr = curr->left.get();
+            }
+
+            curr = stack[--depth];
+            if (prev != nullptr && curr->val <= prev->val) {
+                return false;
+            }
+
+            prev = curr;
+            curr = curr->right.get();
+        }
+        return true;
+    }
+
+    // Morris in-order traversal: the rightmost node of each left subtree
+    // temporarily points back at its in-order successor instead of using a
+    // stack. The walk always runs to the end so every thread is removed again.
+    bool isValidBSTMorris(TreeNode<T>* curr) {
+        // A throwing comparison would leave threaded (doubly owned) links behind
+        static_assert(noexcept(std::declval<const T&>() <= std::declval<const T&>()),
+                      "Morris traversal requires a non-throwing comparison");
+
+        const TreeNode<T>* prev = nullptr;
+        bool valid = true;
+        auto visit = [&](const TreeNode<T>* node) {
+            if (prev != nullptr && node->val <= prev->val) {
+                valid = false;
+            }
+            prev = node;
+        };
+
+        while (curr != nullptr) {
+            if (!curr->left) {
+                visit(curr);
+                curr = curr->right.get();
+                continue;
+            }
+
+            TreeNode<T>* pred = curr->left.get();
+            while (pred->right && pred->right.get() != curr) {
+                pred = pred->right.get();
+            }
+
+            if (!pred->right) {
+                // Thread: non-owning back link, dropped with release() below
+                pred->right.reset(curr);
+                curr = curr->left.get();
+            } else {
+                (void)pred->right.release();
+                visit(curr);
+                curr = curr->right.get();
+            }
+        }
+        return valid;
+    }
+    // Parallel validation: every node must lie strictly inside the key range
+    // inherited from its ancestors, so disjoint subtrees can be checked
+    // independently. The top of the tree is expanded into a frontier of
+    // subtrees which worker threads claim one by one; the first violation
+    // found stops the remaining workers.
+    ValidationResult<T> isValidBSTParallel(const std::unique_ptr<TreeNode<T>>& root,
+                                           unsigned threads = std::thread::hardware_concurrency()) {
+        threads = std::max(threads, 1u);
+
+        // Bounds point at ancestor keys, so no key is ever copied
+        struct Task {
+            const TreeNode<T>* node;
+            const T* lower;
+            const T* upper;
+        };
+
+        auto out_of_range = [](const Task& task) {
+            const T& val = task.node->val;
+            return (task.lower != nullptr && val <= *task.lower) ||
+                   (task.upper != nullptr && val >= *task.upper);
+        };
+
+        // Expand breadth-first until there are a few subtrees per thread.
+        // Expansion is capped so a degenerate (list-shaped) tree is handed
+        // to a worker instead of being walked here.
+        std::vector<Task> frontier;
+        if (root) frontier.push_back({root.get(), nullptr, nullptr});
+        const size_t target = threads == 1 ? 1 : static_cast<size_t>(threads) * 4;
+        constexpr size_t kMaxExpanded = 1 << 16;
+        size_t head = 0;
+        while (head < frontier.size() && frontier.size() - head < target && head < kMaxExpanded) {
+            Task task = frontier[head++];
+            if (out_of_range(task)) {
+                return {false, task.node};
+            }
+            const T* key = &task.node->val;
+            if (task.node->left) frontier.push_back({task.node->left.get(), task.lower, key});
+            if (task.node->right) frontier.push_back({task.node->right.get(), key, task.upper});
+        }
+        // Expanded nodes are already checked; keep only the open subtrees
+        frontier.erase(frontier.begin(), frontier.begin() + static_cast<std::ptrdiff_t>(head));
+
+        std::atomic<size_t> next{0};
+        std::atomic<const TreeNode<T>*> offending{nullptr};
+        std::stop_source stop;
+
+        auto worker = [&](std::stop_token token) {
+            std::vector<Task> pending;
+            while (!token.stop_requested()) {
+                size_t index = next.fetch_add(1, std::memory_order_relaxed);
+                if (index >= frontier.size()) return;
+
+                pending.push_back(frontier[index]);
+                // Check the stop flag every few thousand nodes, not every node
+                for (size_t visited = 0; !pending.empty(); ++visited) {
+                    if ((visited & 4095) == 0 && token.stop_requested()) return;
+
+                    Task task = pending.back();
+                    pending.pop_back();
+                    if (out_of_range(task)) {
+                        const TreeNode<T>* expected = nullptr;
+                        offending.compare_exchange_strong(expected, task.node);
+                        stop.request_stop();
+                        return;
+                    }
+                    const T* key = &task.node->val;
+                    if (task.node->right) pending.push_back({task.node->right.get(), key, task.upper});
+                    if (task.node->left) pending.push_back({task.node->left.get(), task.lower, key});
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> workers;
+            size_t extra = std::min<size_t>(threads, frontier.size());
+            for (size_t i = 1; i < extra; ++i) {
+                workers.emplace_back([&] { worker(stop.get_token()); });
+            }
+            // The calling thread works too instead of just waiting
+            worker(stop.get_token());
+        } // jthreads join here
+
+        const TreeNode<T>* bad = offending.load();
+        return {bad == nullptr, bad};
+    }
 };
 
+// See codestudio_library() in CMakeLists.txt
+#ifndef CODESTUDIO_NO_MAIN
 int main() {
     // --- Test with int ---
     // Modern C++: Use std::make_unique to prevent memory leaks automatically
@@ -77,6 +379,20 @@ int main() {
     bool result_int_invalid = s_int.isValidBST(root_int_invalid);
     std::cout << "Is Valid BST (int - invalid): " << (result_int_invalid ? "Yes" : "No") << std::endl;
 
+    // Allocation-free traversal policies
+    std::cout << "Is Valid BST (int - valid, Morris): "
+              << (s_int.isValidBST<MorrisTraversal>(root_int_valid) ? "Yes" : "No") << std::endl;
+    std::cout << "Is Valid BST (int - invalid, inline stack): "
+              << (s_int.isValidBST<InlineStackTraversal<64>>(root_int_invalid) ? "Yes" : "No") << std::endl;
+
+    // Parallel validator gives the same verdict and points at the culprit
+    auto parallel_invalid = s_int.isValidBSTParallel(root_int_invalid);
+    std::cout << "Is Valid BST (int - invalid, parallel): " << (parallel_invalid ? "Yes" : "No");
+    if (parallel_invalid.offending) {
+        std::cout << " (offending node " << parallel_invalid.offending->val << ")";
+    }
+    std::cout << std::endl;
+
     // --- Test with std::string ---
     // Valid string BST
     auto root_string_valid = std::make_unique<TreeNode<std::string>>("banana");
@@ -95,6 +411,23 @@ int main() {
     bool result_string_invalid = s_string.isValidBST(root_string_invalid);
     std::cout << "Is Valid BST (string - invalid): " << (result_string_invalid ? "Yes" : "No") << std::endl;
     
+    // Same trees with prefix-compared keys in one shared string arena
+    StringArena strings;
+    auto key = [&strings](std::string_view text) { return StringKey(text, strings); };
+    auto root_key_valid = std::make_unique<TreeNode<StringKey>>(key("banana"));
+    root_key_valid->left = std::make_unique<TreeNode<StringKey>>(key("apple"));
+    root_key_valid->right = std::make_unique<TreeNode<StringKey>>(key("bananarama")); // ties on the 8-byte prefix
+    root_key_valid->left->left = std::make_unique<TreeNode<StringKey>>(key("")); // empty sorts first
+    Solution<StringKey> s_key;
+    std::cout << "Is Valid BST (StringKey - valid): " << (s_key.isValidBST(root_key_valid) ? "Yes" : "No")
+              << std::endl;
+    std::cout << "Empty key ordering: \"\" < \"\\0\": " << (key("") < key(std::string_view("\0", 1)) ? "yes" : "no")
+              << ", \"\" == \"\": " << (key("") == key("") ? "yes" : "no") << std::endl;
+    root_key_valid->right->left = std::make_unique<TreeNode<StringKey>>(key("apricot")); // < "banana"
+    std::cout << "Is Valid BST (StringKey - invalid, Morris): "
+              << (s_key.isValidBST<MorrisTraversal>(root_key_valid) ? "Yes" : "No") << std::endl;
+
     // root is automatically destroyed here. No leak.
     return 0;
-}
\ No newline at end of file
+}
+#endif // CODESTUDIO_NO_MAIN